@@ -0,0 +1,108 @@
+#include <problemmdd.h>
+#include <timer.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random.hpp>
+
+// Move given by a selected element and a position in nonSelected, as the
+// virtual factorized fitness receives it
+struct Move {
+    int element;
+    size_t selectedIdx;
+    size_t nonSelectedIdx;
+};
+
+// Concrete call that cannot be inlined, as when evaluateSwap was compiled
+// in its own translation unit
+__attribute__((noinline))
+tFitness outOfLineSwap(const ProblemMDD& problem, const MDDSolutionInfo& info,
+                       size_t selectedIdx, size_t nonSelectedIdx) {
+    return problem.evaluateSwap(info, selectedIdx, nonSelectedIdx);
+}
+
+// Microbenchmark of the cost of reaching the swap evaluation
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> [calls]" << std::endl;
+        return 1;
+    }
+
+    try {
+        int calls = (argc > 2) ? std::stoi(argv[2]) : 1000000;
+        Random::seed(42);
+
+        ProblemMDD problem(argv[1]);
+        std::cout << "Instance: " << problem.getInstanceName() << std::endl;
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+
+        tSolution solution = problem.createSolution();
+        MDDSolutionInfo* info = problem.generateFactoringInfo(MDDSubset(solution));
+
+        std::vector<Move> moves(calls);
+        for (auto& move : moves) {
+            move.selectedIdx = Random::get<size_t>(0, info->selected.size() - 1);
+            // The virtual fitness receives the position as a tDomain (bool),
+            // so only the first two non-selected positions can be used
+            move.nonSelectedIdx = Random::get<size_t>(0, 1);
+            move.element = info->selected[move.selectedIdx];
+        }
+
+        // Same moves through each path; the checksums must agree
+        Problem* base = &problem;
+        Timer timer;
+        double checksums[3] = {0, 0, 0};
+        double seconds[3];
+
+        // Warm up the caches and the branch predictors
+        double warmup = 0;
+        for (const auto& move : moves) {
+            warmup += problem.evaluateSwap(*info, move.selectedIdx, move.nonSelectedIdx);
+        }
+
+        timer.start();
+        for (const auto& move : moves) {
+            checksums[0] += base->fitness(solution, info, move.element, move.nonSelectedIdx);
+        }
+        timer.stop();
+        seconds[0] = timer.elapsed();
+
+        timer.reset();
+        timer.start();
+        for (const auto& move : moves) {
+            checksums[1] += outOfLineSwap(problem, *info, move.selectedIdx, move.nonSelectedIdx);
+        }
+        timer.stop();
+        seconds[1] = timer.elapsed();
+
+        timer.reset();
+        timer.start();
+        for (const auto& move : moves) {
+            checksums[2] += problem.evaluateSwap(*info, move.selectedIdx, move.nonSelectedIdx);
+        }
+        timer.stop();
+        seconds[2] = timer.elapsed();
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Calls: " << calls << std::endl;
+        std::cout << "Virtual fitness + dynamic_cast: " << seconds[0] * 1e9 / calls << " ns/call" << std::endl;
+        std::cout << "Concrete call, not inlined: " << seconds[1] * 1e9 / calls << " ns/call" << std::endl;
+        std::cout << "Inlined (template path): " << seconds[2] * 1e9 / calls << " ns/call" << std::endl;
+        std::cout << std::setprecision(2) << "Dispatch overhead removed: "
+                  << (seconds[0] - seconds[2]) * 1e9 / calls << " ns/call ("
+                  << seconds[0] / seconds[2] << "x)" << std::endl;
+
+        if (checksums[0] == warmup && checksums[0] == checksums[2] && checksums[1] == checksums[2]) {
+            std::cout << "All paths give the same results!" << std::endl;
+        } else {
+            std::cout << "ERROR: The paths give different results!" << std::endl;
+        }
+
+        delete info;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,155 @@
+#include <problemmdd.h>
+#include <localsearchmdd.h>
+#include <timer.h>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <random.hpp>
+
+// Previous factorized evaluation: copies the sums, updates them in three
+// passes and looks for the extremes with max_element/min_element
+float copySwapFitness(const ProblemMDD& problem, const MDDSolutionInfo& info,
+                      size_t selectedIdx, size_t nonSelectedIdx) {
+    const DistanceMatrix& distances = problem.getDistances();
+    const float* rowOut = distances.row(info.selected[selectedIdx]);
+    const float* rowIn = distances.row(info.nonSelected[nonSelectedIdx]);
+
+    std::vector<float> newSumDistances = info.sumDistances;
+    for (size_t i = 0; i < info.selected.size(); i++) {
+        if (i != selectedIdx) {
+            newSumDistances[i] -= rowOut[info.selected[i]];
+        }
+    }
+    for (size_t i = 0; i < info.selected.size(); i++) {
+        if (i != selectedIdx) {
+            newSumDistances[i] += rowIn[info.selected[i]];
+        }
+    }
+    float newSum = 0.0f;
+    for (size_t i = 0; i < info.selected.size(); i++) {
+        if (i != selectedIdx) {
+            newSum += rowIn[info.selected[i]];
+        }
+    }
+    newSumDistances[selectedIdx] = newSum;
+
+    float maxSum = *std::max_element(newSumDistances.begin(), newSumDistances.end());
+    float minSum = *std::min_element(newSumDistances.begin(), newSumDistances.end());
+    return maxSum - minSum;
+}
+
+// Runs a local search from a fixed seed, hiding its progress messages
+ResultMH runLocalSearch(ProblemMDD& problem, long seed, double& seconds) {
+    LocalSearchMDD localSearch(ExplorationStrategy::RANDOM);
+    std::ostringstream hidden;
+    std::streambuf* previous = std::cout.rdbuf(hidden.rdbuf());
+    Random::seed(seed);
+    Timer timer;
+    timer.start();
+    ResultMH result = localSearch.optimize(&problem, 100000);
+    timer.stop();
+    std::cout.rdbuf(previous);
+    seconds = timer.elapsed();
+    return result;
+}
+
+// Microbenchmark of the factorized swap evaluation
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> [calls]" << std::endl;
+        return 1;
+    }
+
+    try {
+        int calls = (argc > 2) ? std::stoi(argv[2]) : 1000000;
+        Random::seed(42);
+
+        ProblemMDD problem(argv[1]);
+        std::cout << "Instance: " << problem.getInstanceName() << std::endl;
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+
+        tSolution solution = problem.createSolution();
+        SolutionFactoringInfo* factorInfo = problem.generateFactoringInfo(solution);
+        MDDSolutionInfo* info = dynamic_cast<MDDSolutionInfo*>(factorInfo);
+
+        // Same sequence of moves for both versions
+        std::vector<std::pair<size_t, size_t>> moves(calls);
+        for (auto& move : moves) {
+            move.first = Random::get<size_t>(0, info->selected.size() - 1);
+            move.second = Random::get<size_t>(0, info->nonSelected.size() - 1);
+        }
+
+        Timer timer;
+        double checksumBefore = 0, checksumAfter = 0;
+
+        timer.start();
+        for (const auto& move : moves) {
+            checksumBefore += copySwapFitness(problem, *info, move.first, move.second);
+        }
+        timer.stop();
+        double before = timer.elapsed();
+
+        timer.reset();
+        timer.start();
+        for (const auto& move : moves) {
+            checksumAfter += problem.evaluateSwap(*info, move.first, move.second);
+        }
+        timer.stop();
+        double after = timer.elapsed();
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Calls: " << calls << std::endl;
+        std::cout << "Copy + three passes: " << before * 1e9 / calls << " ns/call" << std::endl;
+        std::cout << "Single pass, no allocation: " << after * 1e9 / calls << " ns/call" << std::endl;
+        std::cout << std::setprecision(2) << "Speedup: " << before / after << "x" << std::endl;
+
+        // Sums may be rounded in a different order, so compare with a tolerance
+        if (std::abs(checksumBefore - checksumAfter) <= 1e-5 * std::abs(checksumBefore)) {
+            std::cout << "Both versions give the same results!" << std::endl;
+        } else {
+            std::cout << "ERROR: The versions give different results!" << std::endl;
+        }
+
+        // Screening with the 16-bit quantized distances
+        problem.enableQuantization();
+        std::cout << std::scientific << "\nQuantization error bound: " << problem.getQuantizationError()
+                  << " (measured: " << problem.getMeasuredQuantizationError() << ")"
+                  << std::fixed << std::endl;
+
+        // The bound must never exceed the exact value, nor the error its bound
+        int rejected = 0;
+        bool sound = problem.getMeasuredQuantizationError() <= problem.getQuantizationError();
+        for (const auto& move : moves) {
+            float exact = problem.evaluateSwap(*info, move.first, move.second);
+            float bound = problem.swapLowerBound(*info, move.first, move.second);
+            if (bound > exact) sound = false;
+            if (bound >= info->dispersion()) rejected++;
+        }
+        std::cout << "Moves discarded by the bound: " << 100.0 * rejected / calls << "%" << std::endl;
+
+        // Local search with and without the screening (same seed, same search)
+        double exactSeconds, screenedSeconds;
+        ProblemMDD exactProblem(argv[1]);
+        ResultMH exactResult = runLocalSearch(exactProblem, 42, exactSeconds);
+        ResultMH screenedResult = runLocalSearch(problem, 42, screenedSeconds);
+        std::cout << "LocalSearch exact: " << exactSeconds * 1000 << " ms, screened: "
+                  << screenedSeconds * 1000 << " ms (speedup "
+                  << exactSeconds / screenedSeconds << "x)" << std::endl;
+        if (sound && screenedResult.fitness == exactResult.fitness &&
+            screenedResult.solution == exactResult.solution) {
+            std::cout << "Screening gives the same search!" << std::endl;
+        } else {
+            std::cout << "ERROR: Screening changes the search!" << std::endl;
+        }
+
+        delete factorInfo;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,3 +1,4 @@
+#pragma once
 #include <mh.h>
 
 /**
@@ -9,16 +10,19 @@ public:
   virtual ~MHTrayectory() {}
   /**
    * Run the Trayectory-based metaheuristic algorithm to find the optimal
-   * solution.
+   * solution, from a random one.
    *
    * @param problem  The problem to solve.
-   * @param maxevals The maximum number of evaluations.
+   * @param maxevals The maximum number of evaluations, including the one of
+   *                 the initial solution.
    * @see MHTrayectory::optimize()
    */
   ResultMH optimize(Problem *problem, int maxevals) override {
     tSolution initial = problem->createSolution();
     tFitness fitness = problem->fitness(initial);
-    return optimize(problem, initial, fitness, maxevals);
+    ResultMH result = optimize(problem, initial, fitness, maxevals - 1);
+    result.evaluations++;
+    return result;
   }
 
 public:
@@ -6,8 +6,8 @@
 #include <utility>
 
 // get base random alias which is auto seeded and has static API and internal
-// state it is not threads secure, you can also use ::random_thread_local
-using Random = effolkronium::random_static;
+// state, one per thread (each thread has its own engine, seeded on its own)
+using Random = effolkronium::random_thread_local;
 
 /**
  * Class that represent information useful for factorized solution.
@@ -22,6 +22,10 @@ public:
 /**
  * Problem class to solve the given problem in metaheuristic.
  *
+ * The evaluation methods are const, and must not modify shared state, so
+ * that a single problem can be evaluated from several threads at once.
+ * createSolution uses the Random of the calling thread.
+ *
  * @author your_name
  * @version 1.0
  */
@@ -33,7 +37,23 @@ public:
    * Evaluate the solution from scratch.
    * @param solution to evaluate.
    */
-  virtual tFitness fitness(const tSolution &solution) = 0;
+  virtual tFitness fitness(const tSolution &solution) const = 0;
+  /**
+   * Evaluate several solutions.
+   *
+   * By default it evaluates them one by one. However, it can be override to
+   * share work between the solutions of the batch.
+   *
+   * @param solutions to evaluate.
+   * @param count number of solutions.
+   * @param fitnesses to store the fitness of each solution.
+   */
+  virtual void fitnessBatch(const tSolution *solutions, size_t count,
+                            tFitness *fitnesses) const {
+    for (size_t i = 0; i < count; i++) {
+      fitnesses[i] = fitness(solutions[i]);
+    }
+  }
   /**
    * Evaluate the solution indicating the current position to change and the new
    * value.
@@ -49,7 +69,7 @@ public:
    */
   virtual tFitness fitness(const tSolution &solution,
                            SolutionFactoringInfo *solution_info,
-                           unsigned pos_change, tDomain new_value) {
+                           unsigned pos_change, tDomain new_value) const {
     tSolution newsol(solution);
     newsol[pos_change] = new_value;
     return fitness(newsol);
@@ -62,7 +82,7 @@ public:
    * @return the solution information.
    */
   virtual SolutionFactoringInfo *
-  generateFactoringInfo(const tSolution &solution) {
+  generateFactoringInfo(const tSolution &solution) const {
     return new SolutionFactoringInfo();
   }
 
@@ -77,7 +97,7 @@ public:
   virtual void updateSolutionFactoringInfo(SolutionFactoringInfo *solution_info,
                                            const tSolution &solution,
                                            unsigned pos_change,
-                                           tDomain new_value) {}
+                                           tDomain new_value) const {}
 
   /**
    * Create a new solution.
@@ -86,9 +106,9 @@ public:
   /**
    * Return the current size of the solution.
    */
-  virtual size_t getSolutionSize() = 0; // Get the size of each solution
+  virtual size_t getSolutionSize() const = 0; // Get the size of each solution
   /** Return the range of domain of each element of the solution */
-  virtual std::pair<tDomain, tDomain> getSolutionDomainRange() = 0;
+  virtual std::pair<tDomain, tDomain> getSolutionDomainRange() const = 0;
 };
 
 #endif
@@ -0,0 +1,71 @@
+#include <problemmdd.h>
+#include <instancecache.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+// Converts text instances into binary caches that ProblemMDD maps directly
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file>... [--packed|--tiled] [--verify]" << std::endl;
+        std::cout << "  Writes next to each instance a .mddc cache, for the dense storage" << std::endl;
+        std::cout << "  or (with --packed) for the packed storage, or (with --tiled) a" << std::endl;
+        std::cout << "  .mddt cache of tiles for the tiled storage" << std::endl;
+        std::cout << "  With --verify, only checks that the existing caches match the" << std::endl;
+        std::cout << "  whole contents of their instances" << std::endl;
+        return 1;
+    }
+
+    DistanceStorage storage = DistanceStorage::DENSE;
+    bool verify = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--packed") {
+            storage = DistanceStorage::PACKED;
+        } else if (std::string(argv[i]) == "--tiled") {
+            storage = DistanceStorage::TILED;
+        } else if (std::string(argv[i]) == "--verify") {
+            verify = true;
+        }
+    }
+
+    try {
+        bool allValid = true;
+        for (int i = 1; i < argc; i++) {
+            std::string instance_path = argv[i];
+            if (instance_path == "--packed" || instance_path == "--tiled" || instance_path == "--verify") continue;
+
+            if (verify) {
+                std::string path = (storage == DistanceStorage::TILED) ? tiledCachePath(instance_path)
+                                                                       : instanceCachePath(instance_path);
+                bool valid = ProblemMDD::verifyCache(path, instance_path);
+                allValid &= valid;
+                std::cout << path << ": " << (valid ? "valid" : "stale or missing") << std::endl;
+                continue;
+            }
+
+            if (storage == DistanceStorage::TILED) {
+                // Streamed band by band, the matrix is never loaded whole
+                std::string tiled_path = tiledCachePath(instance_path);
+                ProblemMDD::convertToTiledCache(instance_path, tiled_path);
+                std::cout << instance_path << " -> " << tiled_path << std::endl;
+                continue;
+            }
+
+            // A cache that no longer matches the text must not be the source
+            // of the new one (the load only compares the size and the time)
+            std::string cache_path = instanceCachePath(instance_path);
+            if (!ProblemMDD::verifyCache(cache_path, instance_path)) {
+                std::remove(cache_path.c_str());
+            }
+            ProblemMDD problem(instance_path, storage);
+            problem.saveCache(cache_path, instance_path);
+
+            std::cout << instance_path << " -> " << cache_path
+                      << " (n = " << problem.getN() << ", m = " << problem.getM() << ")" << std::endl;
+        }
+        return allValid ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <simdkernels.h>
+
+/**
+ * Distances between points of a d-dimensional space, computed on demand.
+ *
+ * Only the coordinates are stored (O(n·d) memory instead of O(n^2)), each
+ * point padded with zeros to a multiple of 8 coordinates so the SIMD
+ * Euclidean kernel has no tail. Rows requested often (for example those of
+ * the selected elements during a local search) are computed whole and kept
+ * in a small cache with LRU replacement; a row is cached the second time it
+ * is requested, so rows used once do not pay for the n distances.
+ *
+ * The views of the last two rows requested are always valid. The cache is
+ * modified by const accesses, so one oracle must not be used by several
+ * threads at the same time, unless the cache is disabled.
+ */
+class CoordinateDistanceOracle {
+public:
+    // Memory used by default to cache rows
+    static constexpr size_t DEFAULT_CACHE_BYTES = size_t(64) << 20;
+
+    /**
+     * View of a row: cached values, or distances computed on each access.
+     */
+    class Row {
+    public:
+        Row(const CoordinateDistanceOracle& oracle, int i, const float* cached)
+            : oracle(oracle), i(i), cached(cached) {}
+
+        float operator[](int j) const {
+            return cached ? cached[j] : oracle.compute(i, j);
+        }
+
+    private:
+        const CoordinateDistanceOracle& oracle;
+        int i;
+        const float* cached;
+    };
+
+    /**
+     * Constructor of an empty oracle.
+     */
+    CoordinateDistanceOracle();
+
+    /**
+     * Constructor of an oracle of n points at the origin.
+     *
+     * @param n Number of points
+     * @param dimensions Number of coordinates of each point
+     * @param cacheBytes Memory used to cache rows (0 disables the cache)
+     */
+    CoordinateDistanceOracle(int n, int dimensions, size_t cacheBytes = DEFAULT_CACHE_BYTES);
+
+    /**
+     * Returns the coordinates of point i, to fill them.
+     */
+    float* point(int i) { return coordinates.data() + static_cast<size_t>(i) * stride; }
+
+    /**
+     * Returns the coordinates of point i.
+     */
+    const float* point(int i) const { return coordinates.data() + static_cast<size_t>(i) * stride; }
+
+    /**
+     * Returns the distance between points i and j (it is not cached).
+     */
+    float operator()(int i, int j) const { return compute(i, j); }
+
+    /**
+     * Returns a view of row i, from the cache if it is there.
+     */
+    Row row(int i) const;
+
+    /**
+     * Returns the number of points.
+     */
+    int size() const { return n; }
+
+    /**
+     * Returns the number of coordinates of each point.
+     */
+    int getDimensions() const { return dimensions; }
+
+    /**
+     * Changes the memory used to cache rows (the cache is emptied). The
+     * cache holds at least two rows, unless it is disabled.
+     *
+     * @param cacheBytes Memory used to cache rows (0 disables the cache)
+     */
+    void setCacheSize(size_t cacheBytes);
+
+    /**
+     * Returns the number of rows that fit in the cache (0 if disabled).
+     */
+    int getCacheCapacity() const { return capacity; }
+
+    /**
+     * Returns the number of rows served from the cache.
+     */
+    uint64_t getHits() const { return hits; }
+
+    /**
+     * Returns the number of rows not found in the cache.
+     */
+    uint64_t getMisses() const { return misses; }
+
+    /**
+     * Resets the hit and miss counters.
+     */
+    void resetStats() const { hits = misses = 0; }
+
+private:
+    // Requests of a row needed to cache it
+    static constexpr uint8_t ADMIT_AFTER = 2;
+
+    // Euclidean distance between points i and j
+    float compute(int i, int j) const {
+        return std::sqrt(simd::squaredDistance(point(i), point(j), stride));
+    }
+
+    // Number of points, of coordinates and of floats per point (padded)
+    int n;
+    int dimensions;
+    int stride;
+    // Coordinates of every point
+    std::vector<float> coordinates;
+
+    // Number of rows that fit in the cache and storage for them
+    int capacity;
+    mutable std::vector<float> pool;
+    // Slot of each row (-1 if not cached), and row of each slot
+    mutable std::vector<int> slotOf;
+    mutable std::vector<int> rowOf;
+    // Time of the last use of each slot, to evict the least recent
+    mutable std::vector<uint64_t> lastUse;
+    mutable uint64_t clock;
+    // Requests of each row not cached yet
+    mutable std::vector<uint8_t> requests;
+    // Statistics
+    mutable uint64_t hits, misses;
+};
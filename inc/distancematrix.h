@@ -0,0 +1,222 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * Layout used to store the distances of a problem instance.
+ */
+enum class DistanceStorage {
+    DENSE,  // Full n x n matrix (DistanceMatrix)
+    PACKED, // Upper triangle only (PackedDistanceMatrix), about half the memory
+    TILED,  // Tiles read on demand from disk (TiledDistanceMatrix), for instances larger than RAM
+    COORDINATES // Computed on demand from points (CoordinateDistanceOracle), O(n·d) memory
+};
+
+/**
+ * Square matrix of distances stored in a single contiguous block.
+ *
+ * The matrix is row-major and every row is padded to a multiple of 64 bytes,
+ * so each row starts on a cache line boundary. Accessing an element costs a
+ * single multiply-add instead of the extra pointer chase of a vector of
+ * vectors, and row pointers can be taken once and reused in inner loops.
+ *
+ * The matrix can also be a read-only view of memory owned by someone else
+ * (for example a memory-mapped instance cache), so no copy is needed.
+ */
+class DistanceMatrix {
+public:
+    // Alignment (in bytes) of the storage and of the start of every row
+    static constexpr size_t ALIGNMENT = 64;
+
+    /**
+     * Constructor of an empty matrix.
+     */
+    DistanceMatrix() : n(0), stride(0), base(nullptr) {}
+
+    /**
+     * Constructor of a n x n matrix initialized to zero.
+     *
+     * @param n Number of rows and columns
+     */
+    explicit DistanceMatrix(int n);
+
+    /**
+     * Creates a view of an external n x n matrix with the same layout
+     * (n * paddedStride(n) floats, 64-byte aligned). The memory is not
+     * copied and must outlive the view, which must not be modified.
+     *
+     * @param n Number of rows and columns
+     * @param external Storage of the matrix
+     * @return The view
+     */
+    static DistanceMatrix view(int n, const float* external);
+
+    /**
+     * Returns the stride used for a matrix of n columns.
+     */
+    static size_t paddedStride(int n) {
+        const size_t perLine = ALIGNMENT / sizeof(float);
+        return ((static_cast<size_t>(n) + perLine - 1) / perLine) * perLine;
+    }
+
+    DistanceMatrix(const DistanceMatrix& other);
+    DistanceMatrix& operator=(const DistanceMatrix& other);
+    DistanceMatrix(DistanceMatrix&& other) noexcept = default;
+    DistanceMatrix& operator=(DistanceMatrix&& other) noexcept = default;
+
+    /**
+     * Returns a pointer to the first element of row i.
+     *
+     * @param i Row index
+     * @return Pointer to the (64-byte aligned) row
+     */
+    float* row(int i) { return base + i * stride; }
+    const float* row(int i) const { return base + i * stride; }
+
+    /**
+     * Returns the element (i, j), without bounds checking.
+     */
+    float& operator()(int i, int j) { return base[i * stride + j]; }
+    float operator()(int i, int j) const { return base[i * stride + j]; }
+
+    /**
+     * Returns the whole storage (n * getStride() floats).
+     */
+    const float* raw() const { return base; }
+
+    /**
+     * Returns the number of rows (and columns) of the matrix.
+     */
+    int size() const { return n; }
+
+    /**
+     * Returns the distance, in elements, between the start of two rows.
+     */
+    size_t getStride() const { return stride; }
+
+private:
+    // Releases memory obtained with the aligned operator new[]
+    struct AlignedDeleter {
+        void operator()(float* ptr) const {
+            ::operator delete[](ptr, std::align_val_t(ALIGNMENT));
+        }
+    };
+
+    // Number of rows and columns
+    int n;
+    // Elements between the start of consecutive rows (n rounded up)
+    size_t stride;
+    // Contiguous storage of n * stride elements
+    float* base;
+    // Owner of the storage (empty for a view)
+    std::unique_ptr<float[], AlignedDeleter> data;
+};
+
+/**
+ * Symmetric matrix of distances storing only the upper triangle.
+ *
+ * Row i keeps the elements (i, i..n-1) one after the other, so the whole
+ * matrix takes n * (n + 1) / 2 floats instead of n * n. The diagonal is stored
+ * too, which avoids a branch for i == j in the index mapping. Element (i, j)
+ * is found at rowBase[min(i, j)] + max(i, j), where rowBase is precomputed.
+ */
+class PackedDistanceMatrix {
+public:
+    /**
+     * Lightweight view of a row, so that kernels can index it as row(i)[j]
+     * exactly as with a row pointer of DistanceMatrix.
+     */
+    class Row {
+    public:
+        Row(const PackedDistanceMatrix& matrix, int i) : matrix(matrix), i(i) {}
+        float operator[](int j) const { return matrix(i, j); }
+
+    private:
+        const PackedDistanceMatrix& matrix;
+        int i;
+    };
+
+    /**
+     * Constructor of an empty matrix.
+     */
+    PackedDistanceMatrix() : n(0), base(nullptr) {}
+
+    /**
+     * Constructor of a n x n symmetric matrix initialized to zero.
+     *
+     * @param n Number of rows and columns
+     */
+    explicit PackedDistanceMatrix(int n);
+
+    /**
+     * Creates a view of an external packed matrix with the same layout
+     * (packedSize(n) floats). The memory is not copied and must outlive the
+     * view, which must not be modified.
+     *
+     * @param n Number of rows and columns
+     * @param external Storage of the matrix
+     * @return The view
+     */
+    static PackedDistanceMatrix view(int n, const float* external);
+
+    /**
+     * Returns the number of floats stored for a matrix of n rows.
+     */
+    static size_t packedSize(int n) {
+        return static_cast<size_t>(n) * (n + 1) / 2;
+    }
+
+    PackedDistanceMatrix(const PackedDistanceMatrix& other);
+    PackedDistanceMatrix& operator=(const PackedDistanceMatrix& other);
+    PackedDistanceMatrix(PackedDistanceMatrix&& other) noexcept = default;
+    PackedDistanceMatrix& operator=(PackedDistanceMatrix&& other) noexcept = default;
+
+    /**
+     * Returns the element (i, j) = (j, i), without bounds checking.
+     */
+    float operator()(int i, int j) const { return base[index(i, j)]; }
+
+    /**
+     * Sets the elements (i, j) and (j, i).
+     */
+    void set(int i, int j, float value) { base[index(i, j)] = value; }
+
+    /**
+     * Returns a view of row i.
+     */
+    Row row(int i) const { return Row(*this, i); }
+
+    /**
+     * Returns the position in the packed storage of element (i, j).
+     */
+    size_t index(int i, int j) const {
+        int lo = i < j ? i : j;
+        int hi = i < j ? j : i;
+        return rowBase[lo] + hi;
+    }
+
+    /**
+     * Returns the number of rows (and columns) of the matrix.
+     */
+    int size() const { return n; }
+
+    /**
+     * Returns the whole storage (packedSize(n) floats).
+     */
+    const float* raw() const { return base; }
+
+private:
+    // Fills rowBase for n rows
+    void computeRowBase();
+
+    // Number of rows and columns
+    int n;
+    // Packed upper triangle, diagonal included
+    float* base;
+    // Owner of the storage (empty for a view)
+    std::vector<float> data;
+    // Offset of row i in data, minus i (so that adding j gives the position)
+    std::vector<size_t> rowBase;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <solution.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Bounded cache of fitness values, keyed by a 64-bit hash of the solution
+ * (for the MDD problem, the Zobrist hash of its selection).
+ *
+ * The table is direct-mapped: every key has a single entry, and a new value
+ * replaces whatever was there. It is lock-free: each entry stores the value
+ * and the key XOR the value in two atomic words, so a read that sees half of
+ * a concurrent write does not match its key and is just a miss.
+ *
+ * A value can be exact or only a lower bound of the fitness (an evaluation
+ * stopped at a cutoff), which is enough to discard a move again later.
+ */
+class FitnessCache {
+public:
+    /**
+     * Constructor.
+     *
+     * @param entries Number of entries (rounded up to a power of two)
+     */
+    explicit FitnessCache(size_t entries);
+
+    /**
+     * Looks up a key.
+     *
+     * @param key Hash of the solution
+     * @param value Stored value, if found
+     * @param exact Whether the value is exact or a lower bound, if found
+     * @return true if the key is in the cache
+     */
+    bool lookup(uint64_t key, tFitness& value, bool& exact) const;
+
+    /**
+     * Stores the value of a key, replacing the entry it maps to.
+     *
+     * @param key Hash of the solution
+     * @param value Fitness, or a lower bound of it
+     * @param exact Whether the value is exact
+     */
+    void store(uint64_t key, tFitness value, bool exact);
+
+    /**
+     * Empties the cache (not safe while other threads use it).
+     */
+    void clear();
+
+    /**
+     * Returns the number of entries.
+     */
+    size_t size() const { return mask + 1; }
+
+    /**
+     * Returns the number of lookups that found their key.
+     */
+    uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+
+    /**
+     * Returns the number of lookups that did not find their key.
+     */
+    uint64_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+
+    /**
+     * Returns the fraction of lookups that found their key.
+     */
+    double hitRate() const {
+        uint64_t total = getHits() + getMisses();
+        return total > 0 ? static_cast<double>(getHits()) / total : 0.0;
+    }
+
+    /**
+     * Resets the hit and miss counters.
+     */
+    void resetStats() {
+        hits.store(0, std::memory_order_relaxed);
+        misses.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Value (its bits, and a flag for exact values) and key ^ value
+    struct Entry {
+        std::atomic<uint64_t> data;
+        std::atomic<uint64_t> check;
+    };
+
+    // Entries, and mask to map a key to its entry
+    std::unique_ptr<Entry[]> entries;
+    size_t mask;
+    // Statistics
+    mutable std::atomic<uint64_t> hits;
+    mutable std::atomic<uint64_t> misses;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <mh.h>
+#include <localsearchmdd.h>
+#include <string>
+
+class ProblemMDD;
+
+/**
+ * Implementation of GRASP for the MDD problem.
+ * 
+ * Each iteration builds a randomized greedy solution and improves it with
+ * the local search. The construction starts from a random element and, at
+ * each step, evaluates every candidate with the running sums of GreedyMDD
+ * (SelectionSums) and adds a random one from the restricted candidate
+ * list: those whose dispersion is at most dmin + alpha·(dmax - dmin).
+ * alpha = 0 is the greedy (with random ties) and alpha = 1 a random
+ * construction.
+ * 
+ * The iterations run on a pool of threads and share the best solution found
+ * so far. Each iteration draws its random numbers from its own stream,
+ * derived from a seed taken from Random, and the best solution is chosen by
+ * fitness and then by iteration, so the result does not depend on the
+ * number of threads (as long as the problem has no fitness cache, see
+ * MultiStart).
+ * 
+ * The evaluation budget is split among the iterations, and each candidate
+ * evaluated by a construction counts as an evaluation, as in GreedyMDD;
+ * the local search uses the rest of the budget of its iteration. If the
+ * budget does not allow every iteration to construct a solution and
+ * evaluate it, fewer iterations are run.
+ */
+class GraspMDD : public MH {
+private:
+    double alpha;                 // Parámetro de la lista restringida de candidatos
+    int iterations;               // Número de construcciones
+    ExplorationStrategy strategy; // Estrategia de la búsqueda local
+    unsigned threads;             // Número de hilos
+    
+    /**
+     * Builds a randomized greedy solution, drawing from Random.
+     * 
+     * @param problem The MDD problem to solve
+     * @param evaluations Incremented by the number of candidates evaluated
+     */
+    tSolution constructSolution(const ProblemMDD& problem, int& evaluations) const;
+    
+public:
+    /**
+     * Constructor.
+     * 
+     * @param alpha Threshold of the restricted candidate list, in [0, 1]
+     * @param iterations Number of constructions, each one improved by the local search
+     * @param strategy Exploration strategy of the local search
+     * @param threads Number of threads (1 by default, 0 for one per hardware thread)
+     */
+    GraspMDD(double alpha = 0.3, int iterations = 10,
+             ExplorationStrategy strategy = ExplorationStrategy::HEURISTIC, unsigned threads = 1);
+    
+    /**
+     * Destructor.
+     */
+    virtual ~GraspMDD() {}
+    
+    /**
+     * Run GRASP.
+     * 
+     * @param problem The MDD problem to solve
+     * @param maxevals Maximum number of evaluations of all the iterations together
+     * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+     */
+    ResultMH optimize(Problem* problem, int maxevals) override;
+    
+    /**
+     * Get the name of the algorithm.
+     * 
+     * @return The algorithm name
+     */
+    std::string getName() const { return "GRASP"; }
+};
@@ -1,13 +1,108 @@
 #pragma once
 #include <mh.h>
+#include <random.hpp>
 #include <timer.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
 #include <vector>
 
+/**
+ * Running sums of a greedy construction for the MDD problem (used by
+ * GreedyMDD and GraspMDD): the sum of every selected element to the rest of
+ * the selection, and of every element to the selection. Adding an element
+ * updates them in O(n), and the dispersion of the selection plus a
+ * candidate is then computed in O(m), reading the distances from the
+ * problem without copying them.
+ */
+template <class ProblemT>
+class SelectionSums {
+public:
+    /**
+     * Constructor of an empty selection.
+     * 
+     * @param problem The problem whose distances are used
+     */
+    explicit SelectionSums(const ProblemT& problem)
+        : problem(problem), solution(problem.getN(), false),
+          sumToSelected(problem.getN(), 0.0f) {
+        selectedElements.reserve(problem.getM());
+        selectedSums.reserve(problem.getM());
+    }
+    
+    /**
+     * Adds an element to the selection (O(n)): its sum is the one it had as
+     * a candidate, and that of the others grows with its distance.
+     */
+    void add(int element) {
+        for (size_t j = 0; j < selectedElements.size(); j++) {
+            selectedSums[j] += problem.distance(selectedElements[j], element);
+        }
+        selectedSums.push_back(sumToSelected[element]);
+        selectedElements.push_back(element);
+        solution[element] = true;
+        for (int e = 0; e < static_cast<int>(sumToSelected.size()); e++) {
+            if (e != element) {
+                sumToSelected[e] += problem.distance(e, element);
+            }
+        }
+    }
+    
+    /**
+     * Returns the dispersion of the selection plus a candidate (O(m)). The
+     * scan stops once it reaches the cutoff, and the value is then only a
+     * lower bound.
+     * 
+     * @param candidate A non-selected element
+     * @param cutoff Value from which the exact dispersion is not needed
+     */
+    float dispersionWith(int candidate,
+                         double cutoff = std::numeric_limits<double>::max()) const {
+        float maxSum = sumToSelected[candidate];
+        float minSum = sumToSelected[candidate];
+        for (size_t j = 0; j < selectedElements.size() && maxSum - minSum < cutoff; j++) {
+            float sum = selectedSums[j] + problem.distance(selectedElements[j], candidate);
+            maxSum = std::max(maxSum, sum);
+            minSum = std::min(minSum, sum);
+        }
+        return maxSum - minSum;
+    }
+    
+    /**
+     * Checks if an element is selected.
+     */
+    bool isSelected(int element) const { return solution[element]; }
+    
+    /**
+     * Returns the selected elements, in the order they were added.
+     */
+    const std::vector<int>& selected() const { return selectedElements; }
+    
+    /**
+     * Returns the selection as a binary solution.
+     */
+    const tSolution& getSolution() const { return solution; }
+    
+private:
+    const ProblemT& problem;
+    // Selección (binaria y en orden de inserción)
+    tSolution solution;
+    std::vector<int> selectedElements;
+    // Suma de cada seleccionado a los demás, y de cada elemento a la selección
+    std::vector<float> selectedSums;
+    std::vector<float> sumToSelected;
+};
+
 /**
  * Implementation of the Greedy algorithm for the MDD problem.
  * 
  * Starts with a random element and selects m-1 more based on 
  * which elements minimize the dispersion with the already selected ones.
+ *
+ * The sums of the selected elements and of every candidate to the
+ * selection are kept from one step to the next (see SelectionSums), so
+ * each candidate is evaluated in O(m) and each step costs O(n·m).
  */
 class GreedyMDD : public MH {
 public:
@@ -30,10 +125,115 @@ public:
      */
     ResultMH optimize(Problem* problem, int maxevals) override;
     
+    /**
+     * Run the Greedy algorithm on a concrete problem type, without virtual
+     * calls nor casts. optimize is a thin wrapper over it.
+     * 
+     * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+     * @return A ResultMH containing the solution found, its fitness, and the number of evaluations
+     */
+    template <class ProblemT>
+    ResultMH construct(ProblemT& problem);
+    
     /**
      * Get the name of the algorithm.
      * 
      * @return The algorithm name
      */
     std::string getName() const { return "GreedyMDD"; }
-}; 
\ No newline at end of file
+};
+
+/**
+ * Run the Greedy algorithm on a concrete problem type.
+ * 
+ * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+ * @return A ResultMH containing the solution found, its fitness, and the number of evaluations
+ */
+template <class ProblemT>
+ResultMH GreedyMDD::construct(ProblemT& problem) {
+    // Inicializar temporizador
+    Timer timer;
+    timer.start();
+    
+    // Obtener n y m del problema
+    int n = problem.getN();
+    int m = problem.getM();
+    
+    // Contador de evaluaciones
+    int evaluations = 0;
+    
+    // Selección y sumas que se mantienen en cada paso
+    SelectionSums<ProblemT> sums(problem);
+    
+    // Seleccionamos el primer elemento aleatoriamente
+    int firstElement = Random::get<int>(0, n-1);
+    sums.add(firstElement);
+    
+    std::cout << "Greedy: Seleccionado primer elemento " << firstElement << " aleatoriamente" << std::endl;
+    
+    // Seleccionamos los m-1 elementos restantes
+    for (int iter = 1; iter < m; iter++) {
+        double bestDisp = std::numeric_limits<double>::max();
+        int bestElement = -1;
+        
+        // Probar cada elemento no seleccionado (en orden, como candidatos)
+        for (int candidate = 0; candidate < n; candidate++) {
+            if (sums.isSelected(candidate)) {
+                continue;
+            }
+            
+            // Dispersión que resultaría al añadir este elemento (O(m)); se deja
+            // de calcular en cuanto no puede mejorar a la mejor encontrada
+            float dispersion = sums.dispersionWith(candidate, bestDisp);
+            
+            evaluations++;
+            
+            // Si mejora la dispersión, actualizamos el mejor elemento
+            if (dispersion < bestDisp) {
+                bestDisp = dispersion;
+                bestElement = candidate;
+            }
+        }
+        
+        // Añadimos el mejor elemento a la solución
+        if (bestElement != -1) {
+            sums.add(bestElement);
+            
+            std::cout << "Greedy: Seleccionado elemento " << bestElement 
+                      << " (dispersión: " << bestDisp << ")" << std::endl;
+        } else {
+            std::cerr << "Error: No se pudo encontrar un elemento para añadir." << std::endl;
+            break;
+        }
+    }
+    
+    // Solución construida y sus elementos
+    tSolution solution = sums.getSolution();
+    std::vector<int> selectedElements = sums.selected();
+    
+    // Calculamos el fitness final
+    double finalFitness = problem.fitness(solution);
+    evaluations++;
+    
+    // Detenemos el temporizador
+    timer.stop();
+    
+    // Ordenar los elementos seleccionados para mostrarlos
+    std::sort(selectedElements.begin(), selectedElements.end());
+    
+    // Mostrar resultados
+    std::cout << "\nGreedy-MDD completado en " << std::fixed << std::setprecision(2)
+              << timer.elapsed() << " segundos." << std::endl;
+    std::cout << "Fitness final: " << finalFitness << std::endl;
+    std::cout << "Elementos seleccionados: ";
+    for (size_t i = 0; i < selectedElements.size(); i++) {
+        std::cout << selectedElements[i];
+        if (i < selectedElements.size() - 1) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << std::endl;
+    
+    // Devolver el resultado
+    return ResultMH(solution, finalFitness, evaluations);
+}
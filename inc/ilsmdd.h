@@ -0,0 +1,59 @@
+#pragma once
+#include <mh.h>
+#include <localsearchmdd.h>
+#include <string>
+
+/**
+ * Implementation of Iterated Local Search for the MDD problem.
+ * 
+ * Descends from a random solution to a local optimum and then, while there
+ * are evaluations left, perturbs the best optimum found with k random swaps
+ * and descends again, keeping the new optimum if it is better. The whole
+ * run shares a single evaluation budget. Each optimum is evaluated in full
+ * (one evaluation of the budget), so the optima are compared, and the best
+ * one returned, with their exact fitness rather than with the value of the
+ * incrementally updated sums.
+ * 
+ * The factoring information is built once: the swaps of the perturbation
+ * are applied to it (ProblemMDD::applySwap, as updateSolutionFactoringInfo
+ * does), and the best optimum is kept in a second info that is copied over
+ * (O(n), reusing its storage), so a restart costs O(k·(n + m)) instead of
+ * rebuilding the info in O(m²+n·m).
+ */
+class IteratedLocalSearchMDD : public MH {
+private:
+    int perturbationSize;         // Intercambios de cada perturbación (0: m/10)
+    ExplorationStrategy strategy; // Estrategia de la búsqueda local
+    
+public:
+    /**
+     * Constructor.
+     * 
+     * @param perturbationSize Number of random swaps of each perturbation (0 for m/10, at least one)
+     * @param strategy Exploration strategy of the local search
+     */
+    IteratedLocalSearchMDD(int perturbationSize = 0,
+                           ExplorationStrategy strategy = ExplorationStrategy::HEURISTIC)
+        : MH(), perturbationSize(perturbationSize), strategy(strategy) {}
+    
+    /**
+     * Destructor.
+     */
+    virtual ~IteratedLocalSearchMDD() {}
+    
+    /**
+     * Run Iterated Local Search.
+     * 
+     * @param problem The MDD problem to solve
+     * @param maxevals Maximum number of evaluations of the whole run
+     * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+     */
+    ResultMH optimize(Problem* problem, int maxevals) override;
+    
+    /**
+     * Get the name of the algorithm.
+     * 
+     * @return The algorithm name
+     */
+    std::string getName() const { return "ILS"; }
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Header of the binary cache of a MDD instance.
+ *
+ * The file holds this header (128 bytes) followed by the distances in the
+ * layout of the storage used (DistanceMatrix rows with their padding, or the
+ * PackedDistanceMatrix triangle), so that it can be memory-mapped and used
+ * directly without parsing nor copying. The payload starts at a multiple of
+ * 64 bytes, keeping the rows aligned.
+ *
+ * Tiled caches (extension ".mddt") hold the tiles of a TiledDistanceMatrix
+ * instead, which are read on demand rather than mapped.
+ */
+struct InstanceCacheHeader {
+    // Identifier of the format
+    char magic[8];
+    // Version of the format
+    uint32_t version;
+    // Layout of the payload (DistanceStorage)
+    uint32_t storage;
+    // Number of elements and of elements to select
+    int32_t n;
+    int32_t m;
+    // Size, modification time and hash of the text instance the cache was
+    // created from (0 if unknown). Loads compare the size and the time; the
+    // hash, which needs the whole text, only on request
+    uint64_t textSize;
+    int64_t textTime;
+    uint64_t textHash;
+    // Size of the payload in bytes
+    uint64_t payloadBytes;
+    // Checksum of the payload
+    uint64_t checksum;
+    // Name of the instance
+    char name[56];
+    // Side of the tiles of a tiled payload (0 for other layouts)
+    uint32_t tileSize;
+    // Unused, keeps the header at 128 bytes
+    char reserved[4];
+};
+
+static_assert(sizeof(InstanceCacheHeader) == 128, "The cache header must take 128 bytes");
+
+// Identifier and version of the cache format
+constexpr char INSTANCE_CACHE_MAGIC[8] = {'M', 'D', 'D', 'C', 'A', 'C', 'H', 'E'};
+constexpr uint32_t INSTANCE_CACHE_VERSION = 3;
+
+/**
+ * Returns the path of the binary cache of a text instance: the same path
+ * with the extension replaced by ".mddc".
+ *
+ * @param filename The path to the text instance
+ * @return The path to its cache
+ */
+std::string instanceCachePath(const std::string& filename);
+
+/**
+ * Returns the path of the tiled cache of a text instance: the same path
+ * with the extension replaced by ".mddt".
+ *
+ * @param filename The path to the text instance
+ * @return The path to its tiled cache
+ */
+std::string tiledCachePath(const std::string& filename);
+
+/**
+ * Computes the checksum (64-bit FNV-1a over 64-bit words) of a block.
+ *
+ * @param data Start of the block
+ * @param bytes Size of the block
+ * @return The checksum
+ */
+uint64_t instanceChecksum(const void* data, size_t bytes);
+
+/**
+ * Reads the size and modification time of a text instance, which are stored
+ * in the header of its caches and compared on every load without reading
+ * the text.
+ *
+ * @param textPath The path to the text instance
+ * @param size Size of the text in bytes
+ * @param time Modification time of the text (in ticks of the file clock)
+ * @return false if the text does not exist (size and time are set to 0)
+ */
+bool instanceTextStamp(const std::string& textPath, uint64_t& size, int64_t& time);
+
+/**
+ * Computes the fingerprint of a text instance stored in the header of its
+ * caches: its size and the checksum of its contents, so that an instance
+ * edited in place is detected even if its size and time do not change.
+ * It reads the whole text.
+ *
+ * @param textPath The path to the text instance
+ * @param size Size of the text in bytes
+ * @param hash Checksum of the text
+ * @return false if the text cannot be opened (size and hash are set to 0)
+ */
+bool instanceTextFingerprint(const std::string& textPath, uint64_t& size, uint64_t& hash);
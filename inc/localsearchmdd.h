@@ -1,6 +1,12 @@
 #pragma once
 #include <mh.h>
+#include <mddsubset.h>
 #include <timer.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random.hpp>
 #include <vector>
 #include <string>
 
@@ -9,28 +15,69 @@
  */
 enum class ExplorationStrategy {
     RANDOM,  // Exploración en orden aleatorio (randLS)
-    HEURISTIC // Exploración basada en heurística (heurLS)
+    HEURISTIC, // Exploración basada en heurística (heurLS)
+    BEST     // Mejor mejora con tabla de intercambios (bestLS)
 };
 
 /**
  * Implementation of the Local Search algorithm for the MDD problem.
  * 
- * Uses the first-improvement strategy and Int(Sel,i,j) move that swaps
+ * Uses the first-improvement strategy (randLS, heurLS) or the
+ * best-improvement one (bestLS), and Int(Sel,i,j) move that swaps
  * a selected element i with a non-selected element j.
  * Stops when no improvement is found in the entire neighborhood or when
  * the maximum number of evaluations is reached.
+ *
+ * The best-improvement strategy keeps an m x (n-m) table with the sum of
+ * every non-selected element to the selection if it replaced every selected
+ * one. The table is updated after each swap in O(m·(n-m)) instead of being
+ * rebuilt. With two more sums per selected slot (O(m^2) per iteration),
+ * it gives in O(1) a lower bound of the dispersion after every swap, and
+ * only the moves whose bound is below the best value found are evaluated
+ * in O(m), so the result is that of evaluating them all. The scan starts
+ * at the move whose new element is closest to the centre of the current
+ * sums, so that a good value is known early.
+ *
+ * If the problem has a quantized copy of its distances (see
+ * ProblemMDD::enableQuantization), every move is first screened with its
+ * lower bound and only the promising ones are evaluated exactly, so the
+ * search and its result are the same.
  */
 class LocalSearchMDD : public MH {
 private:
     ExplorationStrategy strategy; // Estrategia de exploración
+    bool verbose; // Mostrar el progreso por la salida estándar
+    
+    /**
+     * Fills the swap table of the best-improvement strategy: entry
+     * (i, j) is the sum of nonSelected[j] to the selection without
+     * selected[i], stored row-major.
+     */
+    template <class ProblemT>
+    static void buildSwapTable(const ProblemT& problem, const typename ProblemT::Info& info,
+                               std::vector<float>& table);
+    
+    /**
+     * Updates the swap table after applySwap(info, selectedIdx,
+     * nonSelectedIdx): every entry changes by the distance to the added
+     * element minus the distance to the removed one, except the row and
+     * column of the move, which are recomputed.
+     */
+    template <class ProblemT>
+    static void updateSwapTable(const ProblemT& problem, const typename ProblemT::Info& info,
+                                size_t selectedIdx, size_t nonSelectedIdx,
+                                std::vector<float>& table);
     
 public:
     /**
      * Constructor.
      * 
-     * @param strategy The exploration strategy to use (RANDOM or HEURISTIC)
+     * @param strategy The exploration strategy to use (RANDOM, HEURISTIC or BEST)
+     * @param verbose Whether to print the progress (disable it to run
+     *                several searches at once, from other algorithms)
      */
-    LocalSearchMDD(ExplorationStrategy strategy) : MH(), strategy(strategy) {}
+    LocalSearchMDD(ExplorationStrategy strategy, bool verbose = true)
+        : MH(), strategy(strategy), verbose(verbose) {}
     
     /**
      * Destructor.
@@ -46,6 +93,48 @@ public:
      */
     ResultMH optimize(Problem* problem, int maxevals) override;
     
+    /**
+     * Run the Local Search algorithm on a concrete problem type, without
+     * virtual calls nor casts: the evaluation of the moves is inlined into
+     * the neighborhood loop. optimize is a thin wrapper over it.
+     * 
+     * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+     * @param maxevals Maximum number of evaluations (stops at 100,000 or when no improvement is found)
+     * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+     */
+    template <class ProblemT>
+    ResultMH search(ProblemT& problem, int maxevals);
+    
+    /**
+     * Run the Local Search algorithm on a concrete problem type from a
+     * given solution (for example, a constructed one) instead of a random
+     * one.
+     * 
+     * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+     * @param maxevals Maximum number of evaluations (stops at 100,000 or when no improvement is found)
+     * @param initial The initial solution, with m elements selected
+     * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+     */
+    template <class ProblemT>
+    ResultMH search(ProblemT& problem, int maxevals, tSolution initial);
+    
+    /**
+     * Descend from a solution to a local optimum, updating in place the
+     * solution, its fitness and its factoring information, so that the
+     * search can go on from there without rebuilding it (for example, after
+     * a perturbation, see IteratedLocalSearchMDD).
+     * 
+     * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+     * @param info Factoring information of the solution (kept up to date)
+     * @param currentSolution The solution (kept up to date)
+     * @param currentFitness Its fitness (kept up to date)
+     * @param maxevals Maximum number of evaluations
+     * @return The number of evaluations used
+     */
+    template <class ProblemT>
+    int improve(ProblemT& problem, typename ProblemT::Info& info,
+                tSolution& currentSolution, double& currentFitness, int maxevals);
+    
     /**
      * Get the name of the algorithm.
      * 
@@ -54,8 +143,401 @@ public:
     std::string getName() const {
         if (strategy == ExplorationStrategy::RANDOM) {
             return "randLS";
-        } else {
+        } else if (strategy == ExplorationStrategy::HEURISTIC) {
             return "heurLS";
+        } else {
+            return "bestLS";
+        }
+    }
+};
+
+/**
+ * Run the Local Search algorithm on a concrete problem type.
+ * 
+ * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+ * @param maxevals Maximum number of evaluations (stops at 100,000 or when no improvement is found)
+ * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+ */
+template <class ProblemT>
+ResultMH LocalSearchMDD::search(ProblemT& problem, int maxevals) {
+    // Partimos de una solución inicial aleatoria
+    return search(problem, maxevals, problem.createSolution());
+}
+
+/**
+ * Run the Local Search algorithm on a concrete problem type from a given
+ * solution.
+ * 
+ * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+ * @param maxevals Maximum number of evaluations (stops at 100,000 or when no improvement is found)
+ * @param initial The initial solution, with m elements selected
+ * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+ */
+template <class ProblemT>
+ResultMH LocalSearchMDD::search(ProblemT& problem, int maxevals, tSolution initial) {
+    // Máximo de evaluaciones (100,000 como indica el guión)
+    const int MAX_EVALS = 100000;
+    if (maxevals <= 0 || maxevals > MAX_EVALS) {
+        maxevals = MAX_EVALS;
+    }
+    
+    // Inicializar temporizador
+    Timer timer;
+    timer.start();
+    
+    // Solución inicial
+    tSolution currentSolution = std::move(initial);
+    
+    // Evaluamos la solución inicial
+    double currentFitness = problem.fitness(currentSolution);
+    int evaluations = 1;
+    
+    if (verbose) {
+        std::cout << "LocalSearch (" << getName() << "): Solución inicial con fitness " 
+                  << currentFitness << std::endl;
+    }
+    
+    // Generamos información de factorización para acelerar la búsqueda local.
+    // Contiene los elementos seleccionados y no seleccionados, que se mantienen
+    // actualizados en cada intercambio, así que no hace falta reconstruirlos.
+    // Se toma del pool del hilo y se devuelve a él al salir de la función
+    typename ProblemT::InfoHandle info = problem.makeFactoringInfo(MDDSubset(currentSolution));
+    
+    // Descendemos hasta un óptimo local con el resto de evaluaciones
+    evaluations += improve(problem, *info, currentSolution, currentFitness, maxevals - evaluations);
+    
+    // Detenemos el temporizador
+    timer.stop();
+    
+    // Mostrar resultados
+    if (verbose) {
+        std::cout << "\nLocalSearch (" << getName() << ") completado en " << std::fixed << std::setprecision(2)
+                  << timer.elapsed() << " segundos." << std::endl;
+        std::cout << "Fitness final: " << currentFitness << std::endl;
+        std::cout << "Evaluaciones: " << evaluations << std::endl;
+    }
+    
+    // Devolver el resultado
+    return ResultMH(currentSolution, currentFitness, evaluations);
+}
+
+/**
+ * Descend from a solution to a local optimum, updating in place the
+ * solution, its fitness and its factoring information.
+ * 
+ * @param problem The problem to solve (ProblemMDD, or any type with the same interface)
+ * @param info Factoring information of the solution (kept up to date)
+ * @param currentSolution The solution (kept up to date)
+ * @param currentFitness Its fitness (kept up to date)
+ * @param maxevals Maximum number of evaluations
+ * @return The number of evaluations used
+ */
+template <class ProblemT>
+int LocalSearchMDD::improve(ProblemT& problem, typename ProblemT::Info& info,
+                            tSolution& currentSolution, double& currentFitness, int maxevals) {
+    int evaluations = 0;
+    
+    const std::vector<int>& selectedElements = info.selected;
+    const std::vector<int>& nonSelectedElements = info.nonSelected;
+    
+    // Criba de los movimientos con las distancias cuantizadas (si existen)
+    const bool quantized = problem.isQuantized();
+    
+    // Tabla de intercambios del mejor (se mantiene en cada intercambio), y
+    // para cada hueco las sumas menor y mayor del resto sin él, con sus huecos
+    std::vector<float> swapTable;
+    std::vector<size_t> lowSlot, highSlot;
+    std::vector<float> lowSum, highSum;
+    if (strategy == ExplorationStrategy::BEST) {
+        buildSwapTable(problem, info, swapTable);
+        lowSlot.resize(selectedElements.size());
+        highSlot.resize(selectedElements.size());
+        lowSum.resize(selectedElements.size());
+        highSum.resize(selectedElements.size());
+    }
+    
+    // Flag para saber si se ha mejorado en la iteración actual
+    bool improved = true;
+    
+    // Iteramos mientras haya mejora y no se supere el límite de evaluaciones
+    while (improved && evaluations < maxevals) {
+        improved = false;
+        
+        // Mejor mejora: se evalúa todo el entorno y se aplica el mejor movimiento
+        if (strategy == ExplorationStrategy::BEST) {
+            const size_t numNonSelected = nonSelectedElements.size();
+            
+            // Empezamos por el movimiento cuyo elemento nuevo tiene la suma más
+            // cercana al centro de las sumas actuales: suele ser de los mejores,
+            // y su valor sirve de corte para descartar pronto los demás
+            const float center = (info.sumDistances[info.maxSlot] +
+                                  info.sumDistances[info.minSlot]) / 2;
+            size_t first = 0;
+            for (size_t k = 1; k < swapTable.size(); k++) {
+                if (std::abs(swapTable[k] - center) < std::abs(swapTable[first] - center)) {
+                    first = k;
+                }
+            }
+            
+            // Para cada hueco i, las sumas de los demás seleccionados sin el
+            // elemento i, y los huecos de la menor y la mayor (O(m^2)). Al
+            // cambiar i por j, esos dos elementos suman además d(k, j), así
+            // que la mayor suma nueva es al menos la del mayor, y la menor
+            // como mucho la del menor: con la suma de j (la tabla) dan una
+            // cota inferior de la dispersión en O(1)
+            const size_t numSelected = selectedElements.size();
+            const bool bounded = numSelected > 1;
+            if (bounded) {
+                for (size_t i = 0; i < numSelected; i++) {
+                    lowSlot[i] = highSlot[i] = (i == 0) ? 1 : 0;
+                    lowSum[i] = highSum[i] = info.sumDistances[lowSlot[i]] -
+                        problem.distance(selectedElements[lowSlot[i]], selectedElements[i]);
+                    for (size_t k = 0; k < numSelected; k++) {
+                        if (k == i) continue;
+                        float sum = info.sumDistances[k] -
+                                    problem.distance(selectedElements[k], selectedElements[i]);
+                        if (sum < lowSum[i]) {
+                            lowSum[i] = sum;
+                            lowSlot[i] = k;
+                        }
+                        if (sum > highSum[i]) {
+                            highSum[i] = sum;
+                            highSlot[i] = k;
+                        }
+                    }
+                }
+            }
+            // Margen para el redondeo de las sumas de la tabla, que se
+            // actualizan de forma incremental
+            const double margin = 1e-4 * std::max(1.0f, std::abs(info.sumDistances[info.maxSlot]));
+            
+            // Recorremos la tabla desde ese movimiento, con el mejor valor
+            // encontrado (o el actual) como corte. Los movimientos cuya cota no
+            // lo mejora no se evalúan, aunque cuentan como evaluación (como los
+            // cribados con las distancias cuantizadas), así que el recorrido y
+            // su resultado son los mismos que evaluándolos todos
+            double bestFitness = currentFitness;
+            size_t bestMove = swapTable.size();
+            float limit = bestFitness + margin;
+            size_t k = first;
+            size_t selectedIdx = first / numNonSelected;
+            size_t nonSelectedIdx = first % numNonSelected;
+            // Elementos de la menor y la mayor suma de la fila actual
+            int lowElem = selectedElements[lowSlot[selectedIdx]];
+            int highElem = selectedElements[highSlot[selectedIdx]];
+            for (size_t step = 0; step < swapTable.size() && evaluations < maxevals; step++) {
+                double newFitness = bestFitness;
+                bool promising = true;
+                if (bounded) {
+                    int candidate = nonSelectedElements[nonSelectedIdx];
+                    float added = swapTable[k];
+                    float high = highSum[selectedIdx] + problem.distance(highElem, candidate);
+                    float low = lowSum[selectedIdx] + problem.distance(lowElem, candidate);
+                    promising = std::max(added, high) - std::min(added, low) < limit;
+                }
+                if (promising && (!quantized ||
+                    problem.swapLowerBound(info, selectedIdx, nonSelectedIdx, bestFitness) < bestFitness)) {
+                    newFitness = problem.evaluateSwap(info, selectedIdx, nonSelectedIdx, bestFitness);
+                }
+                evaluations++;
+                
+                if (newFitness < bestFitness) {
+                    bestFitness = newFitness;
+                    bestMove = k;
+                    limit = bestFitness + margin;
+                }
+                
+                // Siguiente entrada de la tabla (por filas, volviendo al principio)
+                if (++nonSelectedIdx == numNonSelected) {
+                    nonSelectedIdx = 0;
+                    if (++selectedIdx == numSelected) {
+                        selectedIdx = 0;
+                    }
+                    if (bounded) {
+                        lowElem = selectedElements[lowSlot[selectedIdx]];
+                        highElem = selectedElements[highSlot[selectedIdx]];
+                    }
+                }
+                k = selectedIdx * numNonSelected + nonSelectedIdx;
+            }
+            
+            // Aplicamos el mejor movimiento si mejora
+            if (bestMove < swapTable.size()) {
+                selectedIdx = bestMove / numNonSelected;
+                nonSelectedIdx = bestMove % numNonSelected;
+                int selectedElem = selectedElements[selectedIdx];
+                int nonSelectedElem = nonSelectedElements[nonSelectedIdx];
+                
+                currentSolution[selectedElem] = false;
+                currentSolution[nonSelectedElem] = true;
+                currentFitness = bestFitness;
+                problem.applySwap(info, selectedIdx, nonSelectedIdx);
+                updateSwapTable(problem, info, selectedIdx, nonSelectedIdx, swapTable);
+                improved = true;
+                
+                if (verbose) {
+                    std::cout << "LocalSearch (" << getName() << "): Mejora encontrada - Intercambio " 
+                              << selectedElem << " por " << nonSelectedElem 
+                              << " (nuevo fitness: " << currentFitness << ")" << std::endl;
+                }
+            }
+            continue;
+        }
+        
+        // Exploración del entorno (Int(Sel,i,j) - intercambiar seleccionado i por no seleccionado j)
+        
+        // Creamos vectores de índices para recorrer los elementos seleccionados y no seleccionados
+        std::vector<int> selectedIndices(selectedElements.size());
+        for (size_t i = 0; i < selectedIndices.size(); i++) {
+            selectedIndices[i] = i;
+        }
+        
+        std::vector<int> nonSelectedIndices(nonSelectedElements.size());
+        for (size_t i = 0; i < nonSelectedIndices.size(); i++) {
+            nonSelectedIndices[i] = i;
+        }
+        
+        // Si es estrategia aleatoria, mezclamos los índices
+        if (strategy == ExplorationStrategy::RANDOM) {
+            Random::shuffle(selectedIndices.begin(), selectedIndices.end());
+            Random::shuffle(nonSelectedIndices.begin(), nonSelectedIndices.end());
+        }
+        // Si es estrategia heurística, ordenamos los índices según la heurística
+        else if (strategy == ExplorationStrategy::HEURISTIC) {
+            // Calculamos la contribución de cada elemento a la dispersión
+            std::vector<std::pair<int, float>> selectedContributions;
+            std::vector<std::pair<int, float>> nonSelectedContributions;
+            
+            // Contribución de elementos seleccionados (cuánto contribuye cada elemento al fitness)
+            {
+                for (size_t i = 0; i < selectedIndices.size(); i++) {
+                    selectedContributions.push_back({i, info.sumDistances[i]});
+                }
+                
+                // Ordenamos de mayor a menor contribución (los que más contribuyen se exploran primero)
+                // porque queremos quitar primero los que más contribuyen al fitness alto
+                std::sort(selectedContributions.begin(), selectedContributions.end(), 
+                        [](const std::pair<int, float>& a, const std::pair<int, float>& b) {
+                            return a.second > b.second;
+                        });
+                
+                // Actualizamos los índices ordenados
+                for (size_t i = 0; i < selectedIndices.size(); i++) {
+                    selectedIndices[i] = selectedContributions[i].first;
+                }
+                
+                // Para los no seleccionados, calcularíamos su potencial contribución
+                // Pero como no tenemos una manera directa de calcularlo, los dejamos en orden aleatorio
+                Random::shuffle(nonSelectedIndices.begin(), nonSelectedIndices.end());
+            }
+        }
+        
+        // Exploramos el entorno (primer mejor)
+        for (size_t i = 0; i < selectedIndices.size() && !improved && evaluations < maxevals; i++) {
+            int selectedIdx = selectedIndices[i];
+            int selectedElem = selectedElements[selectedIdx];
+            
+            for (size_t j = 0; j < nonSelectedIndices.size() && !improved && evaluations < maxevals; j++) {
+                int nonSelectedIdx = nonSelectedIndices[j];
+                int nonSelectedElem = nonSelectedElements[nonSelectedIdx];
+                
+                // Calcular fitness factorizado para el movimiento Int(Sel,i,j)
+                // (usando las posiciones en la información de factorización). Con el
+                // fitness actual como corte se descarta pronto un movimiento que no mejora.
+                // Si hay distancias cuantizadas, se descartan primero con la cota inferior
+                // y solo los movimientos prometedores se evalúan de forma exacta
+                double newFitness = currentFitness;
+                if (!quantized ||
+                    problem.swapLowerBound(info, selectedIdx, nonSelectedIdx, currentFitness) < currentFitness) {
+                    newFitness = problem.evaluateSwap(info, selectedIdx, nonSelectedIdx, currentFitness);
+                }
+                evaluations++;
+                
+                // Si mejora, realizamos el movimiento
+                if (newFitness < currentFitness) {
+                    // Actualizar la solución y fitness
+                    currentSolution[selectedElem] = false;
+                    currentSolution[nonSelectedElem] = true;
+                    currentFitness = newFitness;
+                    
+                    // Actualizar la información de factorización (y con ella los
+                    // vectores de elementos seleccionados y no seleccionados)
+                    problem.applySwap(info, selectedIdx, nonSelectedIdx);
+                    
+                    improved = true;
+                    
+                    if (verbose) {
+                        std::cout << "LocalSearch (" << getName() << "): Mejora encontrada - Intercambio " 
+                                  << selectedElem << " por " << nonSelectedElem 
+                                  << " (nuevo fitness: " << currentFitness << ")" << std::endl;
+                    }
+                    
+                    // En el esquema del primer mejor, rompemos el bucle al encontrar una mejora
+                    break;
+                }
+            }
+        }
+    }
+    
+    return evaluations;
+}
+
+/**
+ * Fills the swap table of the best-improvement strategy.
+ */
+template <class ProblemT>
+void LocalSearchMDD::buildSwapTable(const ProblemT& problem, const typename ProblemT::Info& info,
+                                    std::vector<float>& table) {
+    const size_t numSelected = info.selected.size();
+    const size_t numNonSelected = info.nonSelected.size();
+    table.resize(numSelected * numNonSelected);
+    
+    for (size_t i = 0; i < numSelected; i++) {
+        float* row = table.data() + i * numNonSelected;
+        for (size_t j = 0; j < numNonSelected; j++) {
+            int candidate = info.nonSelected[j];
+            row[j] = info.sumToSelected[candidate] - problem.distance(info.selected[i], candidate);
+        }
+    }
+}
+
+/**
+ * Updates the swap table after a swap.
+ */
+template <class ProblemT>
+void LocalSearchMDD::updateSwapTable(const ProblemT& problem, const typename ProblemT::Info& info,
+                                     size_t selectedIdx, size_t nonSelectedIdx,
+                                     std::vector<float>& table) {
+    const size_t numSelected = info.selected.size();
+    const size_t numNonSelected = info.nonSelected.size();
+    // Tras applySwap, el elemento añadido ocupa la posición del quitado y viceversa
+    const int added = info.selected[selectedIdx];
+    const int removed = info.nonSelected[nonSelectedIdx];
+    
+    // Cambio de la suma de cada no seleccionado a la selección (O(n-m))
+    std::vector<float> shift(numNonSelected);
+    for (size_t j = 0; j < numNonSelected; j++) {
+        int candidate = info.nonSelected[j];
+        shift[j] = problem.distance(candidate, added) - problem.distance(candidate, removed);
+    }
+    
+    // El resto de entradas solo cambian en ese desplazamiento: un bucle
+    // contiguo por fila, sin accesos a la matriz (O(m·(n-m)))
+    for (size_t i = 0; i < numSelected; i++) {
+        float* row = table.data() + i * numNonSelected;
+        if (i == selectedIdx) {
+            // Fila del elemento añadido: se recalcula
+            for (size_t j = 0; j < numNonSelected; j++) {
+                int candidate = info.nonSelected[j];
+                row[j] = info.sumToSelected[candidate] - problem.distance(added, candidate);
+            }
+        } else {
+            for (size_t j = 0; j < numNonSelected; j++) {
+                row[j] += shift[j];
+            }
+            // Columna del elemento quitado: se recalcula
+            row[nonSelectedIdx] = info.sumToSelected[removed] -
+                                  problem.distance(info.selected[i], removed);
         }
     }
-}; 
\ No newline at end of file
+}
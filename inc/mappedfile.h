@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only view of a whole file mapped in memory.
+ *
+ * The file is mapped with mmap, so its contents are read lazily by the
+ * operating system and are not copied into a user buffer. On systems without
+ * mmap the file is read into memory instead.
+ */
+class MappedFile {
+public:
+    /**
+     * Constructor that maps a file.
+     *
+     * @param filename The path to the file
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& filename);
+
+    /**
+     * Destructor: unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Returns the first byte of the file.
+     */
+    const char* begin() const { return data; }
+
+    /**
+     * Returns the byte past the end of the file.
+     */
+    const char* end() const { return data + length; }
+
+    /**
+     * Returns the size of the file in bytes.
+     */
+    size_t size() const { return length; }
+
+private:
+    // Contents of the file
+    const char* data;
+    // Size of the file in bytes
+    size_t length;
+    // True if data has been mapped (false if it has been allocated)
+    bool mapped;
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <solution.h>
+#include <vector>
+
+/**
+ * Subset of selected elements for the MDD problem, stored as a partition.
+ *
+ * All the n elements are kept in a single array where the first m ones are
+ * the selected elements and the rest the non-selected ones, together with the
+ * position of every element in that array. The selected elements can be
+ * traversed directly (without scanning the n flags of a tSolution), membership
+ * is checked in O(1) and swapping a selected with a non-selected element is
+ * O(1).
+ */
+class MDDSubset {
+private:
+    // Elements: [0, m) selected, [m, n) non-selected
+    std::vector<int> partition;
+    // Position of each element in partition
+    std::vector<int> position;
+    // Number of selected elements
+    int m;
+
+public:
+    /**
+     * Constructor of an empty subset.
+     */
+    MDDSubset() : m(0) {}
+
+    /**
+     * Constructor of a subset of n elements where the first m are selected.
+     *
+     * @param n Number of elements
+     * @param m Number of selected elements
+     */
+    MDDSubset(int n, int m);
+
+    /**
+     * Constructor from a binary solution.
+     *
+     * @param solution Solution where true means selected
+     */
+    explicit MDDSubset(const tSolution& solution);
+
+    /**
+     * Restores the initial partition, in order and with the first m
+     * elements selected, without allocating.
+     */
+    void reset();
+
+    /**
+     * Converts the subset into a binary solution.
+     *
+     * @return Solution where true means selected
+     */
+    tSolution toSolution() const;
+
+    /**
+     * Returns the selected elements (numSelected() of them).
+     */
+    const int* selected() const { return partition.data(); }
+
+    /**
+     * Returns the non-selected elements (numNonSelected() of them).
+     */
+    const int* nonSelected() const { return partition.data() + m; }
+
+    /**
+     * Returns the number of selected elements.
+     */
+    int numSelected() const { return m; }
+
+    /**
+     * Returns the number of non-selected elements.
+     */
+    int numNonSelected() const { return static_cast<int>(partition.size()) - m; }
+
+    /**
+     * Returns the total number of elements.
+     */
+    int size() const { return static_cast<int>(partition.size()); }
+
+    /**
+     * Checks if an element is selected.
+     */
+    bool isSelected(int element) const { return position[element] < m; }
+
+    /**
+     * Returns the position of an element in selected() if it is selected, or
+     * in nonSelected() otherwise.
+     */
+    int slot(int element) const {
+        int pos = position[element];
+        return pos < m ? pos : pos - m;
+    }
+
+    /**
+     * Swaps the selected element at selectedIdx with the non-selected element
+     * at nonSelectedIdx; both elements exchange their positions.
+     *
+     * @param selectedIdx Position in selected()
+     * @param nonSelectedIdx Position in nonSelected()
+     */
+    void swap(int selectedIdx, int nonSelectedIdx) {
+        exchange(selectedIdx, m + nonSelectedIdx);
+    }
+
+    /**
+     * Exchanges two positions of the partition (a selected and a
+     * non-selected one, or two positions in the same part).
+     *
+     * @param a First position in the partition
+     * @param b Second position in the partition
+     */
+    void exchange(int a, int b) {
+        int elemA = partition[a];
+        int elemB = partition[b];
+        partition[a] = elemB;
+        partition[b] = elemA;
+        position[elemB] = a;
+        position[elemA] = b;
+    }
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <mh.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * Parallel multi-start driver: runs several independent starts of a
+ * metaheuristic (for example LocalSearchMDD) on a pool of threads and
+ * returns the best result.
+ *
+ * All the starts share the problem, which is only evaluated, so it must be
+ * thread-safe when several threads are used (see ProblemMDD::isThreadSafe).
+ * Each start creates its own metaheuristic and draws its random numbers
+ * from the Random of its thread, reseeded from the index of the start, and
+ * the best result is chosen by fitness and then by index. So, for a given
+ * seed of the calling thread, the result does not depend on the number of
+ * threads, as long as the evaluation of the problem does not depend on what
+ * the other starts have evaluated (for ProblemMDD, without fitness cache).
+ *
+ * The evaluation budget is split among the starts, and the evaluations of
+ * the result are those of all of them.
+ */
+class MultiStart : public MH {
+public:
+    // Creates the metaheuristic of a start
+    using Factory = std::function<std::unique_ptr<MH>()>;
+
+    /**
+     * Constructor.
+     * 
+     * @param factory Creates the metaheuristic run by each start
+     * @param starts Number of starts
+     * @param threads Number of threads (0 for one per hardware thread)
+     */
+    MultiStart(Factory factory, int starts, unsigned threads = 0);
+    
+    /**
+     * Destructor.
+     */
+    virtual ~MultiStart() {}
+    
+    /**
+     * Run every start and return the best result.
+     * 
+     * @param problem The problem to solve (shared by every start)
+     * @param maxevals Maximum number of evaluations of all the starts together
+     * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+     */
+    ResultMH optimize(Problem* problem, int maxevals) override;
+    
+    /**
+     * Get the name of the algorithm.
+     * 
+     * @return The algorithm name
+     */
+    std::string getName() const { return "MultiStart"; }
+
+private:
+    Factory factory;
+    int starts;
+    unsigned threads;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include <problem.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+
+/**
+ * Helpers to run independent tasks on several threads with results that do
+ * not depend on the number of threads: every task draws its random numbers
+ * from its own stream, seeded from the task index, and writes its result to
+ * its own slot.
+ */
+namespace parallel {
+
+/**
+ * Returns the number of threads to use by default (one per hardware
+ * thread, and at least one).
+ */
+unsigned defaultThreads();
+
+/**
+ * Mixing function of splitmix64: consecutive inputs give unrelated outputs.
+ */
+inline uint64_t splitmix64(uint64_t x) {
+    uint64_t z = x + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Returns the seed of a random stream, derived from a base seed.
+ *
+ * @param seed Base seed
+ * @param stream Index of the stream (for example, of the task)
+ */
+inline uint64_t streamSeed(uint64_t seed, uint64_t stream) {
+    return splitmix64(seed ^ splitmix64(stream));
+}
+
+/**
+ * Counter-based random generator: the k-th number of a stream is
+ * splitmix64(key + k·γ), a function of the key and the counter only. A
+ * stream costs nothing to create, so every task (or sample) can have its
+ * own one, independent of the thread that runs it.
+ */
+class CounterEngine {
+public:
+    using result_type = uint64_t;
+
+    /**
+     * Constructor.
+     *
+     * @param key Key of the stream (see streamSeed)
+     * @param counter Position of the first number
+     */
+    explicit CounterEngine(uint64_t key, uint64_t counter = 0) : key(key), counter(counter) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() { return splitmix64(key + counter++ * 0x9e3779b97f4a7c15ULL); }
+
+private:
+    uint64_t key;
+    uint64_t counter;
+};
+
+/**
+ * Seeds the Random of the calling thread with a stream of its own while the
+ * object lives, and restores the previous state of the engine when it is
+ * destroyed, so the state of a thread does not depend on the tasks it has
+ * run (or on whether it has run any).
+ */
+class ScopedRandomStream {
+public:
+    /**
+     * Constructor.
+     *
+     * @param seed Seed of the stream (see streamSeed)
+     */
+    explicit ScopedRandomStream(uint64_t seed) : saved(Random::get_engine()) {
+        std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+        Random::seed(sequence);
+    }
+
+    ~ScopedRandomStream() { Random::engine() = saved; }
+
+    ScopedRandomStream(const ScopedRandomStream&) = delete;
+    ScopedRandomStream& operator=(const ScopedRandomStream&) = delete;
+
+private:
+    Random::engine_type saved;
+};
+
+/**
+ * Runs body(i) for every i in [0, count) on up to the given number of
+ * threads, which take the indices in order as they become free. With a
+ * single thread (or a single task) everything runs in the calling thread.
+ * If a task throws, the first exception (by index) is rethrown once all
+ * the threads have finished.
+ *
+ * @param count Number of tasks
+ * @param threads Number of threads (0 for defaultThreads())
+ * @param body Task to run for each index
+ */
+void parallelFor(size_t count, unsigned threads, const std::function<void(size_t)>& body);
+
+} // namespace parallel
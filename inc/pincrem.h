@@ -7,10 +7,10 @@ class ProblemIncrem : public Problem {
 
 public:
   ProblemIncrem(size_t size) : Problem() { this->size = size; }
-  tFitness fitness(const tSolution &solution) override;
+  tFitness fitness(const tSolution &solution) const override;
   tSolution createSolution() override;
-  size_t getSolutionSize() override { return size; }
-  std::pair<tDomain, tDomain> getSolutionDomainRange() override {
+  size_t getSolutionSize() const override { return size; }
+  std::pair<tDomain, tDomain> getSolutionDomainRange() const override {
     return std::make_pair(false, true);
   }
 };
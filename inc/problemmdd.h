@@ -1,11 +1,26 @@
 #pragma once
+#include <coordinatedistances.h>
+#include <distancematrix.h>
+#include <fitnesscache.h>
+#include <mappedfile.h>
+#include <mddsubset.h>
 #include <problem.h>
+#include <quantizeddistancematrix.h>
+#include <tileddistancematrix.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
 /**
  * Class that represents factorized information for the MDD problem.
  * This stores the sum of distances of each selected element to all other selected elements.
+ * It also keeps, for every element, its slot in selected or nonSelected, so
+ * that a move given by element can be located in O(1), and the slots holding
+ * the maximum and minimum sums.
  */
 class MDDSolutionInfo : public SolutionFactoringInfo {
 public:
@@ -15,14 +30,73 @@ public:
     std::vector<int> selected;
     // Indices of non-selected elements
     std::vector<int> nonSelected;
+    // Position of each element in selected (if selected) or in nonSelected
+    std::vector<int> slot;
+    // Sum of distances of every element (indexed by element) to the selected
+    // ones; for a non-selected element it is its sum if it were added
+    std::vector<float> sumToSelected;
+    // Slots in selected of the elements with the maximum and minimum sums
+    size_t maxSlot = 0;
+    size_t minSlot = 0;
 
     // Constructor
     MDDSolutionInfo() {}
+
+    /**
+     * Returns the position of an element in selected, or -1 if the element
+     * is not selected.
+     *
+     * @param element Index of the element
+     * @return Its slot in selected, or -1
+     */
+    int selectedSlot(unsigned element) const {
+        if (element >= slot.size()) return -1;
+        size_t position = slot[element];
+        if (position < selected.size() && selected[position] == static_cast<int>(element)) {
+            return position;
+        }
+        return -1;
+    }
+
+    /**
+     * Locates the slots with the maximum and minimum sums (O(m)).
+     */
+    void updateExtremes() {
+        maxSlot = minSlot = 0;
+        for (size_t i = 1; i < sumDistances.size(); i++) {
+            if (sumDistances[i] > sumDistances[maxSlot]) maxSlot = i;
+            if (sumDistances[i] < sumDistances[minSlot]) minSlot = i;
+        }
+    }
+
+    /**
+     * Returns the differential dispersion of the current solution (O(1)).
+     */
+    float dispersion() const {
+        return sumDistances[maxSlot] - sumDistances[minSlot];
+    }
     
     // Destructor
     virtual ~MDDSolutionInfo() override = default;
 };
 
+/**
+ * Deleter of MDDSolutionInfoHandle: instead of freeing the info, it keeps it
+ * in a free list of the calling thread, with its vectors still allocated,
+ * so that the next info requested in that thread reuses them. The free list
+ * is bounded; the infos beyond its size are freed.
+ */
+struct MDDSolutionInfoRecycler {
+    void operator()(MDDSolutionInfo* info) const;
+};
+
+/**
+ * Owning handle of a pooled MDDSolutionInfo (see
+ * ProblemMDD::makeFactoringInfo). It is returned to the pool when it is
+ * destroyed, so no delete is needed.
+ */
+using MDDSolutionInfoHandle = std::unique_ptr<MDDSolutionInfo, MDDSolutionInfoRecycler>;
+
 /**
  * Implementation of the MDD (Minimum Differential Dispersion) problem.
  * 
@@ -33,25 +107,179 @@ public:
  * 
  * where sum_distances is the sum of distances from one selected element to all
  * other selected elements.
+ * 
+ * The class is final and evaluateSwap is inline, so algorithms templated on
+ * the problem type (LocalSearchMDD::search, GreedyMDD::construct) evaluate
+ * their moves without virtual calls and can inline them into their loops.
  */
-class ProblemMDD : public Problem {
+class ProblemMDD final : public Problem {
+public:
+    // Type of the factoring information (and of its pooled handle), for
+    // algorithms templated on the problem
+    using Info = MDDSolutionInfo;
+    using InfoHandle = MDDSolutionInfoHandle;
+
 private:
     // Number of elements in the original set
     int n;
     // Number of elements to select
     int m;
-    // Matrix of distances between elements
-    std::vector<std::vector<float>> distances;
+    // Layout chosen to store the distances
+    DistanceStorage storage;
+    // Matrix of distances between elements (contiguous, 64-byte aligned rows)
+    DistanceMatrix distances;
+    // Upper triangle of the distances, used instead of distances when packed
+    PackedDistanceMatrix packedDistances;
+    // Distances read by tiles from disk, used when the storage is tiled
+    TiledDistanceMatrix tiledDistances;
+    // Points of the instance, used when the distances are computed on demand
+    CoordinateDistanceOracle coordinateDistances;
+    // Optional 16-bit copy of the distances, used to screen swaps
+    QuantizedDistanceMatrix quantizedDistances;
     // Name of the instance
     std::string instanceName;
+    // Time spent loading the instance (seconds) and size of its file (bytes)
+    double loadSeconds;
+    size_t loadBytes;
+    // True if the distances come from the binary cache
+    bool cached;
+    // Mapping of the binary cache, used in place by the distance matrix
+    std::shared_ptr<MappedFile> cacheFile;
+
+    /**
+     * Loads the instance from its text file.
+     *
+     * @param filename The path to the text instance
+     * @param loadThreads Number of threads used to parse the file
+     */
+    void loadText(const std::string& filename, int loadThreads);
+
+    /**
+     * Loads the points of an instance given by coordinates: a first line
+     * "n m d" followed by the d coordinates of each of the n points.
+     *
+     * @param filename The path to the coordinates
+     */
+    void loadCoordinates(const std::string& filename);
+
+    /**
+     * Loads the instance from its binary cache, if it exists and it is valid
+     * for the text instance and the storage requested. The cache is mapped
+     * and its distances are used in place, without any copy.
+     *
+     * @param cachePath The path to the binary cache
+     * @param textPath The path to the text instance
+     * @return true if the cache has been loaded
+     */
+    bool loadCache(const std::string& cachePath, const std::string& textPath);
+
+    /**
+     * Opens the tiled cache of the instance, if it exists and it is valid
+     * for the text instance. Only its header is read: the tiles are read on
+     * demand by tiledDistances.
+     *
+     * @param cachePath The path to the tiled cache
+     * @param textPath The path to the text instance
+     * @return true if the cache has been opened
+     */
+    bool loadTiledCache(const std::string& cachePath, const std::string& textPath);
+
+    /**
+     * Parses the lines "i j distance" found in a range of the instance file
+     * and stores the distances.
+     *
+     * @param begin First byte of the range (at the start of a line)
+     * @param end Byte past the end of the range
+     */
+    void parseDistances(const char* begin, const char* end);
+
+    /**
+     * Runs a kernel over the active distance storage. The kernel receives the
+     * matrix and indexes it as d.row(i)[j], so each hot loop is instantiated
+     * once per layout and the layout is checked once per call, not per access.
+     *
+     * @param kernel Generic callable taking the matrix
+     * @return The value returned by the kernel
+     */
+    template <class Kernel>
+    auto withDistances(Kernel&& kernel) const {
+        if (storage == DistanceStorage::PACKED) {
+            return kernel(packedDistances);
+        }
+        if (storage == DistanceStorage::TILED) {
+            return kernel(tiledDistances);
+        }
+        if (storage == DistanceStorage::COORDINATES) {
+            return kernel(coordinateDistances);
+        }
+        return kernel(distances);
+    }
+
+    /**
+     * Differential dispersion of the m elements of a list. The elements are
+     * added in increasing order, so the value does not depend on the order
+     * of the list.
+     *
+     * @param selected The m selected elements
+     * @return max(sum_distances) - min(sum_distances)
+     */
+    tFitness dispersion(const int* selected) const;
+
+    // Random key of each element; the hash of a selection is the XOR of the
+    // keys of its elements
+    std::vector<uint64_t> zobristKeys;
+    // Optional cache of fitness values, keyed by the hash of the selection
+    std::shared_ptr<FitnessCache> fitnessCache;
+
+    /**
+     * Fills factoring information for a subset, reusing the storage of its
+     * vectors.
+     *
+     * @param info The info to fill
+     * @param subset The subset to generate info for
+     */
+    void fillFactoringInfo(MDDSolutionInfo& info, const MDDSubset& subset) const;
+
+    /**
+     * Evaluates a batch of selections without looking them up in the cache.
+     *
+     * @param selections count lists of m selected elements, one after another
+     * @param count Number of selections
+     * @param fitnesses The differential dispersion of each selection
+     */
+    void dispersionBatch(const int* selections, size_t count, tFitness* fitnesses) const;
 
 public:
     /**
      * Constructor that loads a problem instance from a file.
      * 
+     * Only the upper triangle of the distances is given in the file, so with
+     * DistanceStorage::PACKED the matrix takes about half the memory of the
+     * dense layout while the evaluations give exactly the same results.
+     * 
+     * The file is memory-mapped and parsed in place without locale handling,
+     * optionally by several threads, each one parsing a range of lines.
+     * 
+     * If there is a binary cache of the instance (same path with extension
+     * ".mddc", see saveCache) written for the same storage, it is mapped and
+     * used directly instead of parsing the text file.
+     * 
+     * With DistanceStorage::TILED the distances are never held in memory:
+     * they are read by tiles from the tiled cache (extension ".mddt"), which
+     * is written first from the text file if it does not exist (see
+     * convertToTiledCache). Only the most recently used tiles are kept.
+     * 
+     * With DistanceStorage::COORDINATES the file holds points instead (see
+     * loadCoordinates) and the Euclidean distances between them are computed
+     * on demand, caching only the rows used most.
+     * 
      * @param filename The path to the file containing the instance data
+     * @param storage Layout used to store the distances (dense by default)
+     * @param loadThreads Number of threads used to parse the file
      */
-    ProblemMDD(const std::string& filename);
+    ProblemMDD(const std::string& filename,
+               DistanceStorage storage = DistanceStorage::DENSE,
+               int loadThreads = 1);
 
     /**
      * Evaluates a solution by calculating the differential dispersion.
@@ -59,7 +287,44 @@ public:
      * @param solution The solution to evaluate
      * @return The differential dispersion value (to be minimized)
      */
-    tFitness fitness(const tSolution& solution) override;
+    tFitness fitness(const tSolution& solution) const override;
+
+    /**
+     * Evaluates a subset. It avoids scanning the n flags of a tSolution,
+     * since the selected elements are already stored together.
+     * 
+     * @param subset The subset to evaluate
+     * @return The differential dispersion value (to be minimized)
+     */
+    tFitness fitness(const MDDSubset& subset) const;
+
+    /**
+     * Evaluates several solutions at once (see fitnessBatch for lists of
+     * selected elements).
+     * 
+     * @param solutions The solutions to evaluate
+     * @param count Number of solutions
+     * @param fitnesses The differential dispersion of each solution
+     */
+    void fitnessBatch(const tSolution* solutions, size_t count,
+                      tFitness* fitnesses) const override;
+
+    /**
+     * Evaluates several selections at once.
+     * 
+     * The selections are processed in blocks that fit in the cache. Inside
+     * a block the rows of the matrix are visited in order and each one is
+     * loaded once for all the selections of the block that contain its
+     * element, instead of once per selection. Scratch buffers are reused
+     * between calls (one set per thread). The results are the same
+     * as those of fitness. With the fitness cache, only the selections not
+     * found in it are evaluated.
+     * 
+     * @param selections count lists of m selected elements, one after another
+     * @param count Number of selections
+     * @param fitnesses The differential dispersion of each selection
+     */
+    void fitnessBatch(const int* selections, size_t count, tFitness* fitnesses) const;
 
     /**
      * Factorized fitness calculation for local search.
@@ -72,7 +337,131 @@ public:
      */
     tFitness fitness(const tSolution& solution,
                      SolutionFactoringInfo* solution_info,
-                     unsigned pos_change, tDomain new_value) override;
+                     unsigned pos_change, tDomain new_value) const override;
+
+    /**
+     * Evaluates the swap of selected[selectedIdx] with nonSelected[nonSelectedIdx].
+     * 
+     * The new sums are computed on the fly in a single pass and only their
+     * maximum and minimum are kept, so no memory is allocated. The info is
+     * not modified.
+     * 
+     * The slots holding the current extremes are updated first and the scan
+     * stops as soon as the partial dispersion reaches the cutoff, because the
+     * move can no longer be better than it. In that case the returned value
+     * is only a lower bound of the real fitness (but still >= cutoff).
+     * 
+     * @param info Factoring information of the current solution
+     * @param selectedIdx Position in info.selected of the element to remove
+     * @param nonSelectedIdx Position in info.nonSelected of the element to add
+     * @param cutoff Fitness from which the move is not of interest
+     * @return Fitness of the solution after the swap
+     */
+    tFitness evaluateSwap(const MDDSolutionInfo& info, size_t selectedIdx,
+                          size_t nonSelectedIdx,
+                          tFitness cutoff = std::numeric_limits<tFitness>::infinity()) const;
+
+    /**
+     * Creates the cache of fitness values (see FitnessCache), used from then
+     * on by the full evaluations and batches. Only their values are stored:
+     * they depend on the selection alone, so a search gives the same results
+     * with the cache or without it. The values of evaluateSwap come from the
+     * sums of a factoring info, which drift from a full evaluation as the
+     * swaps are applied, and are never cached.
+     * 
+     * @param entries Number of entries of the cache
+     */
+    void enableFitnessCache(size_t entries);
+
+    /**
+     * Removes the cache of fitness values. Without it, the value of an
+     * evaluation does not depend on the evaluations done before (by this
+     * or other threads), so parallel runs are reproducible.
+     */
+    void disableFitnessCache() { fitnessCache.reset(); }
+
+    /**
+     * Returns the cache of fitness values, to read its statistics.
+     * 
+     * @return The cache, or nullptr if it has not been enabled
+     */
+    FitnessCache* getFitnessCache() const { return fitnessCache.get(); }
+
+    /**
+     * Returns the Zobrist key of an element.
+     * 
+     * @param element Index of the element
+     * @return Its random 64-bit key
+     */
+    uint64_t zobristKey(int element) const { return zobristKeys[element]; }
+
+    /**
+     * Returns the Zobrist hash of a selection: the XOR of the keys of its
+     * elements, which does not depend on their order.
+     * 
+     * @param selected The selected elements
+     * @param count Number of selected elements
+     * @return The hash of the selection
+     */
+    uint64_t selectionHash(const int* selected, int count) const;
+
+    /**
+     * Builds the 16-bit quantized copy of the distances used by
+     * swapLowerBound (n^2 16-bit values, half the size of the dense matrix).
+     */
+    void enableQuantization();
+
+    /**
+     * Checks if the quantized copy of the distances has been built.
+     * 
+     * @return true if swapLowerBound can be used
+     */
+    bool isQuantized() const { return !quantizedDistances.empty(); }
+
+    /**
+     * Returns the largest error of a quantized distance.
+     * 
+     * @return Half the quantization step, plus the float rounding (0 if not quantized)
+     */
+    float getQuantizationError() const { return quantizedDistances.errorBound(); }
+
+    /**
+     * Returns the largest error actually found among the quantized distances.
+     * 
+     * @return The measured quantization error (0 if not quantized)
+     */
+    float getMeasuredQuantizationError() const { return quantizedDistances.getMaxError(); }
+
+    /**
+     * Lower bound of evaluateSwap for the same move, computed with the
+     * quantized distances (see enableQuantization).
+     * 
+     * The new sums are estimated from the 16-bit distances and the estimated
+     * dispersion is lowered by the largest error it can have (two distances
+     * per sum, plus rounding), so a move whose bound reaches the cutoff
+     * cannot be better than it and does not need the exact evaluation.
+     * Like evaluateSwap, the scan stops once the bound reaches the cutoff.
+     * 
+     * @param info Factoring information of the current solution
+     * @param selectedIdx Position in info.selected of the element to remove
+     * @param nonSelectedIdx Position in info.nonSelected of the element to add
+     * @param cutoff Fitness from which the move is not of interest
+     * @return A value <= evaluateSwap(info, selectedIdx, nonSelectedIdx)
+     */
+    tFitness swapLowerBound(const MDDSolutionInfo& info, size_t selectedIdx,
+                            size_t nonSelectedIdx,
+                            tFitness cutoff = std::numeric_limits<tFitness>::infinity()) const;
+
+    /**
+     * Applies the swap of selected[selectedIdx] with nonSelected[nonSelectedIdx]
+     * to the factoring information. Both elements exchange their positions.
+     * 
+     * @param info Factoring information to update
+     * @param selectedIdx Position in info.selected of the element to remove
+     * @param nonSelectedIdx Position in info.nonSelected of the element to add
+     */
+    void applySwap(MDDSolutionInfo& info, size_t selectedIdx,
+                   size_t nonSelectedIdx) const;
 
     /**
      * Generates solution factoring information for efficient local search.
@@ -80,7 +469,26 @@ public:
      * @param solution The solution to generate info for
      * @return Pointer to the factoring information
      */
-    SolutionFactoringInfo* generateFactoringInfo(const tSolution& solution) override;
+    SolutionFactoringInfo* generateFactoringInfo(const tSolution& solution) const override;
+
+    /**
+     * Generates solution factoring information directly from a subset.
+     * 
+     * @param subset The subset to generate info for
+     * @return Pointer to the factoring information
+     */
+    MDDSolutionInfo* generateFactoringInfo(const MDDSubset& subset) const;
+
+    /**
+     * Generates solution factoring information from a subset into an info
+     * taken from the pool of the calling thread. A recycled info keeps its
+     * vectors, reserved for n elements, so once the pool is warm this does
+     * not allocate memory.
+     * 
+     * @param subset The subset to generate info for
+     * @return Handle that returns the info to the pool when destroyed
+     */
+    MDDSolutionInfoHandle makeFactoringInfo(const MDDSubset& subset) const;
 
     /**
      * Updates factoring information after a movement is applied.
@@ -93,28 +501,84 @@ public:
     void updateSolutionFactoringInfo(SolutionFactoringInfo* solution_info,
                                      const tSolution& solution,
                                      unsigned pos_change,
-                                     tDomain new_value) override;
+                                     tDomain new_value) const override;
 
     /**
-     * Creates a random valid solution with exactly m elements selected.
+     * Creates a random valid solution with exactly m elements selected,
+     * drawing from the Random of the calling thread.
      * 
      * @return A valid random solution
      */
     tSolution createSolution() override;
 
+    /**
+     * Creates a random valid solution with exactly m elements selected,
+     * drawing from the given generator. Each thread can use its own one.
+     * 
+     * @param engine The random number generator
+     * @return A valid random solution
+     */
+    tSolution createSolution(std::mt19937& engine) const;
+
+    /**
+     * Creates a random subset with exactly m elements selected, drawing
+     * from the Random of the calling thread.
+     * 
+     * @return A valid random subset
+     */
+    MDDSubset createSubset();
+
+    /**
+     * Creates a random subset with exactly m elements selected, drawing
+     * from the given generator.
+     * 
+     * @param engine The random number generator
+     * @return A valid random subset
+     */
+    MDDSubset createSubset(std::mt19937& engine) const;
+
+    /**
+     * Selects m new random elements in an existing subset of n elements,
+     * drawing only m positions and without allocating. It draws from the
+     * Random of the calling thread.
+     * 
+     * @param subset The subset to randomize
+     */
+    void randomizeSubset(MDDSubset& subset);
+
+    /**
+     * Selects m new random elements in an existing subset, drawing from
+     * the given generator (std::mt19937, parallel::CounterEngine or any
+     * other uniform random bit generator).
+     * 
+     * @param subset The subset to randomize
+     * @param engine The random number generator
+     */
+    template <class Engine>
+    void randomizeSubset(MDDSubset& subset, Engine& engine) const;
+
+    /**
+     * Checks if the problem can be evaluated from several threads at once.
+     * It is true for the dense and packed storages, and for coordinates
+     * without row cache: the tile and row caches are not synchronized.
+     * 
+     * @return true if the evaluation methods are thread-safe
+     */
+    bool isThreadSafe() const;
+
     /**
      * Returns the size of the solution (n elements).
      * 
      * @return The solution size
      */
-    size_t getSolutionSize() override { return n; }
+    size_t getSolutionSize() const override { return n; }
 
     /**
      * Returns the range of domain values.
      * 
      * @return Pair of (min, max) domain values
      */
-    std::pair<tDomain, tDomain> getSolutionDomainRange() override {
+    std::pair<tDomain, tDomain> getSolutionDomainRange() const override {
         return std::make_pair(false, true);
     }
 
@@ -127,6 +591,42 @@ public:
      */
     float getDistance(int i, int j) const;
 
+    /**
+     * Returns the distance between two elements without bounds checking.
+     * Intended for inner loops, where the indices are already known to be valid.
+     *
+     * @param i First element index
+     * @param j Second element index
+     * @return The distance between elements i and j
+     */
+    float distance(int i, int j) const {
+        switch (storage) {
+        case DistanceStorage::PACKED:
+            return packedDistances(i, j);
+        case DistanceStorage::TILED:
+            return tiledDistances(i, j);
+        case DistanceStorage::COORDINATES:
+            return coordinateDistances(i, j);
+        default:
+            return distances(i, j);
+        }
+    }
+
+    /**
+     * Returns the layout used to store the distances.
+     *
+     * @return The distance storage
+     */
+    DistanceStorage getStorage() const { return storage; }
+
+    /**
+     * Returns the distance matrix, to allow row pointer access in hot loops.
+     * It is empty unless the instance uses DistanceStorage::DENSE.
+     *
+     * @return The distance matrix
+     */
+    const DistanceMatrix& getDistances() const { return distances; }
+
     /**
      * Returns the number of elements in the original set.
      * 
@@ -147,4 +647,180 @@ public:
      * @return The instance name
      */
     std::string getInstanceName() const { return instanceName; }
-}; 
\ No newline at end of file
+
+    /**
+     * Returns the time spent loading the instance.
+     * 
+     * @return The load time in seconds
+     */
+    double getLoadTime() const { return loadSeconds; }
+
+    /**
+     * Returns the speed at which the instance file has been loaded.
+     * 
+     * @return The load throughput in MB/s
+     */
+    double getLoadThroughput() const {
+        return loadSeconds > 0 ? loadBytes / (loadSeconds * 1e6) : 0.0;
+    }
+
+    /**
+     * Checks if the instance has been loaded from its binary cache.
+     * 
+     * @return true if the distances come from the cache
+     */
+    bool isCached() const { return cached; }
+
+    /**
+     * Changes the memory used to cache tiles when the storage is tiled
+     * (by default TiledDistanceMatrix::DEFAULT_CACHE_BYTES).
+     * 
+     * @param cacheBytes Memory used to cache tiles
+     */
+    void setTileCacheSize(size_t cacheBytes) { tiledDistances.setCacheSize(cacheBytes); }
+
+    /**
+     * Returns the number of tile lookups found in the tile cache (always 0
+     * unless the storage is tiled).
+     * 
+     * @return The number of tile hits
+     */
+    uint64_t getTileHits() const { return tiledDistances.getHits(); }
+
+    /**
+     * Returns the number of tiles read from disk (always 0 unless the
+     * storage is tiled).
+     * 
+     * @return The number of tile misses
+     */
+    uint64_t getTileMisses() const { return tiledDistances.getMisses(); }
+
+    /**
+     * Changes the memory used to cache rows of distances when they are
+     * computed from coordinates (0 disables the cache).
+     * 
+     * @param cacheBytes Memory used to cache rows
+     */
+    void setRowCacheSize(size_t cacheBytes) { coordinateDistances.setCacheSize(cacheBytes); }
+
+    /**
+     * Returns the number of rows served from the row cache (always 0 unless
+     * the distances are computed from coordinates).
+     * 
+     * @return The number of row hits
+     */
+    uint64_t getRowHits() const { return coordinateDistances.getHits(); }
+
+    /**
+     * Returns the number of rows requested that were not in the row cache.
+     * 
+     * @return The number of row misses
+     */
+    uint64_t getRowMisses() const { return coordinateDistances.getMisses(); }
+
+    /**
+     * Writes the binary cache of the instance (see InstanceCacheHeader),
+     * in the storage layout of this problem. The cache is written to a
+     * temporary file that then replaces the old one, so the old cache may be
+     * the one this problem is mapping.
+     * 
+     * @param cachePath The path of the cache to write
+     * @param textPath The path of the text instance, whose size, time and
+     *        hash are stored to detect a stale cache
+     * @throws std::runtime_error if the file cannot be written or the
+     *         storage is not dense nor packed
+     */
+    void saveCache(const std::string& cachePath, const std::string& textPath) const;
+
+    /**
+     * Writes the tiled cache of a text instance, streaming the text one band
+     * of TiledDistanceMatrix::TILE rows at a time, so the whole matrix is
+     * never held in memory. The lines of the text must be sorted by their
+     * smaller index, as in the instances of the problem.
+     * 
+     * @param textPath The path to the text instance
+     * @param cachePath The path of the tiled cache to write
+     * @throws std::runtime_error if the text is invalid or not sorted, or
+     *         the file cannot be written
+     */
+    static void convertToTiledCache(const std::string& textPath, const std::string& cachePath);
+
+    /**
+     * Checks that a cache (dense, packed or tiled) was created from the
+     * current contents of a text instance. Loading a cache only compares the
+     * size and modification time of the text; this also compares the hash of
+     * the whole text, so it detects an edit that kept both, at the cost of
+     * reading the text.
+     * 
+     * @param cachePath The path of the cache
+     * @param textPath The path to the text instance
+     * @return true if the cache exists, is of this format and matches the
+     *         name, size and contents of the text
+     */
+    static bool verifyCache(const std::string& cachePath, const std::string& textPath);
+};
+
+// Select m random elements, reusing the storage of the subset
+template <class Engine>
+inline void ProblemMDD::randomizeSubset(MDDSubset& subset, Engine& engine) const {
+    // Partial Fisher-Yates: only the first m positions have to be drawn
+    for (int i = 0; i < m; i++) {
+        subset.exchange(i, std::uniform_int_distribution<int>(i, n - 1)(engine));
+    }
+}
+
+// Defined here so that it can be inlined into the neighborhood loops
+// Evaluate the swap of two slots in a single pass, without allocating
+inline tFitness ProblemMDD::evaluateSwap(const MDDSolutionInfo& info, size_t selectedIdx,
+                                         size_t nonSelectedIdx, tFitness cutoff) const {
+    const int* selected = info.selected.data();
+    const float* sums = info.sumDistances.data();
+    const size_t count = info.selected.size();
+    const int removed = selected[selectedIdx];
+    const int added = info.nonSelected[nonSelectedIdx];
+    
+    return withDistances([&](const auto& d) {
+        // Rows of the removed and added elements (the matrix is symmetric)
+        auto rowOut = d.row(removed);
+        auto rowIn = d.row(added);
+        
+        // The sum of the added element is known from the cached sums (O(1)),
+        // and it takes the slot of the removed one
+        const float newSum = info.sumToSelected[added] - rowIn[removed];
+        float maxSum = newSum;
+        float minSum = newSum;
+        
+        // Update the sum of a slot on the fly and keep only the extremes
+        auto update = [&](size_t i) {
+            float value = sums[i] - rowOut[selected[i]] + rowIn[selected[i]];
+            maxSum = std::max(maxSum, value);
+            minSum = std::min(minSum, value);
+        };
+        
+        // The elements holding the current extremes usually keep being the
+        // extremes, so they are checked first to reach the cutoff early
+        if (info.maxSlot != selectedIdx) update(info.maxSlot);
+        if (info.minSlot != selectedIdx) update(info.minSlot);
+        if (maxSum - minSum >= cutoff) {
+            return maxSum - minSum;
+        }
+        
+        // Scan the rest; the slot of the removed element is skipped by
+        // splitting the range in two
+        auto accumulate = [&](size_t from, size_t to) {
+            for (size_t i = from; i < to; i++) {
+                update(i);
+                if (maxSum - minSum >= cutoff) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (accumulate(0, selectedIdx)) {
+            accumulate(selectedIdx + 1, count);
+        }
+        
+        // Return the differential dispersion
+        return maxSum - minSum;
+    });
+}
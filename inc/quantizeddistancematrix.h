@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Copy of a distance matrix quantized to 16-bit integers.
+ *
+ * Every distance d is stored as round(d / scale), with the scale chosen so
+ * that the largest distance maps to 32767. It takes half the memory (and
+ * bandwidth) of the float matrix, and every value it returns is within
+ * errorBound() (half a step, plus the float rounding) of the original
+ * distance, so it can be used to discard moves cheaply before evaluating
+ * them exactly.
+ *
+ * Rows are padded to a multiple of 64 bytes, like DistanceMatrix.
+ */
+class QuantizedDistanceMatrix {
+public:
+    /**
+     * Constructor of an empty matrix.
+     */
+    QuantizedDistanceMatrix() : n(0), stride(0), scale(0.0f), maxError(0.0f) {}
+
+    /**
+     * Constructor of a n x n matrix of zeros.
+     *
+     * @param n Number of rows and columns
+     * @param maxAbs Largest absolute value to be stored
+     */
+    QuantizedDistanceMatrix(int n, float maxAbs)
+        : n(n), stride((n + 31) / 32 * 32),
+          scale(maxAbs > 0.0f ? maxAbs / 32767.0f : 1.0f), maxError(0.0f),
+          data(static_cast<size_t>(n) * stride, 0) {}
+
+    /**
+     * Stores the element (i, j), keeping track of the largest error made.
+     */
+    void set(int i, int j, float value) {
+        long q = std::lround(value / scale);
+        if (q > 32767) q = 32767;
+        if (q < -32767) q = -32767;
+        data[static_cast<size_t>(i) * stride + j] = static_cast<int16_t>(q);
+        maxError = std::max(maxError, std::abs(q * scale - value));
+    }
+
+    /**
+     * Returns row i (quantized values, to be multiplied by getScale()).
+     */
+    const int16_t* row(int i) const { return data.data() + static_cast<size_t>(i) * stride; }
+
+    /**
+     * Returns the element (i, j), dequantized.
+     */
+    float operator()(int i, int j) const { return row(i)[j] * scale; }
+
+    /**
+     * Returns the value of one quantization step.
+     */
+    float getScale() const { return scale; }
+
+    /**
+     * Returns the largest possible error of a value: half a step, plus the
+     * float rounding of value / scale and of q * scale (a few ulps of the
+     * largest value).
+     */
+    float errorBound() const {
+        return scale / 2 + 4 * std::numeric_limits<float>::epsilon() * 32767 * scale;
+    }
+
+    /**
+     * Returns the largest error actually made by the values stored.
+     */
+    float getMaxError() const { return maxError; }
+
+    /**
+     * Returns the number of rows (and columns) of the matrix.
+     */
+    int size() const { return n; }
+
+    /**
+     * Checks if the matrix holds no values.
+     */
+    bool empty() const { return n == 0; }
+
+private:
+    // Number of rows and columns, and of values per row (with padding)
+    int n;
+    int stride;
+    // Value of one step, and largest error of the stored values
+    float scale;
+    float maxError;
+    // Row-major quantized values
+    std::vector<int16_t> data;
+};
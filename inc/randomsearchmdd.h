@@ -6,13 +6,24 @@
  * Implementation of the Random Search for the MDD problem.
  * 
  * Generates 100,000 random solutions and returns the best one found.
+ *
+ * The samples are generated and evaluated in batches, which can run on
+ * several threads. Each batch draws from its own counter-based stream
+ * (parallel::CounterEngine), derived from a seed taken from Random, and the
+ * best sample is chosen by fitness and then by index, so the result is the
+ * same with any number of threads.
  */
 class RandomSearchMDD : public MH {
+private:
+    unsigned threads; // Número de hilos
+    
 public:
     /**
      * Constructor.
+     * 
+     * @param threads Number of threads (1 by default, 0 for one per hardware thread)
      */
-    RandomSearchMDD() : MH() {}
+    RandomSearchMDD(unsigned threads = 1) : MH(), threads(threads) {}
     
     /**
      * Destructor.
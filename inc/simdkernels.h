@@ -0,0 +1,59 @@
+#pragma once
+
+/**
+ * Vectorized kernels used by the evaluation of the MDD problem.
+ *
+ * Each kernel has a scalar version and, on x86, SSE and AVX2 versions. The
+ * version to use is chosen once at runtime from the features of the CPU, so
+ * the same binary runs (with the scalar fallback) on any machine.
+ */
+namespace simd {
+
+/**
+ * Sum of row[indices[k]] for k in [0, count).
+ *
+ * @param row Row of the distance matrix
+ * @param indices Columns to add
+ * @param count Number of columns
+ * @return The sum of the gathered values
+ */
+float gatherSum(const float* row, const int* indices, int count);
+
+/**
+ * Sum of values[k] for k in [0, count), added in the same order as
+ * gatherSum, so gathering the values first gives the same result.
+ *
+ * @param values Values to add
+ * @param count Number of values
+ * @return The sum of the values
+ */
+float sum(const float* values, int count);
+
+/**
+ * Difference between the maximum and the minimum of a list of values.
+ *
+ * @param values Values to reduce (at least one)
+ * @param count Number of values
+ * @return max(values) - min(values)
+ */
+float range(const float* values, int count);
+
+/**
+ * Squared Euclidean distance between two points.
+ *
+ * @param a Coordinates of the first point
+ * @param b Coordinates of the second point
+ * @param count Number of coordinates
+ * @return The sum of (a[k] - b[k])^2
+ */
+float squaredDistance(const float* a, const float* b, int count);
+
+/**
+ * Name of the instruction set selected at runtime ("avx2", "sse" or
+ * "scalar"), useful to report which path has been used.
+ *
+ * @return The name of the active kernels
+ */
+const char* kernelName();
+
+} // namespace simd
@@ -0,0 +1,94 @@
+#pragma once
+#include <mhtrayectory.h>
+#include <string>
+#include <vector>
+
+/**
+ * Cooling schedule of the simulated annealing
+ */
+enum class CoolingSchedule {
+    GEOMETRIC,  // T(k+1) = alpha·T(k), tras cada temperatura
+    LUNDY_MEES  // T(k+1) = T(k) / (1 + beta·T(k)), tras cada evaluación, con
+                // beta adaptada al presupuesto para acabar en la temperatura final
+};
+
+/**
+ * Implementation of Simulated Annealing for the MDD problem.
+ * 
+ * At each temperature it samples up to 10·n random swaps Int(Sel,i,j),
+ * scores them with the factorized evaluation (ProblemMDD::evaluateSwap,
+ * O(m)) and accepts them with the Metropolis rule: always if they improve,
+ * and with probability exp(-delta / T) otherwise. A temperature lasts 10·n
+ * swaps or n accepted ones; the geometric schedule cools after each one,
+ * and the Lundy-Mees one after each swap. The search stops when the budget
+ * is spent, the temperature reaches the final one, or (geometric schedule
+ * only) no swap is accepted at a temperature.
+ * 
+ * The random number u of the Metropolis rule is drawn before the
+ * evaluation, so the largest acceptable fitness, f - T·ln(u), is known and
+ * used as cutoff: most rejected swaps stop their scan early. The initial
+ * temperature is mu·f0 / (-ln phi) with mu = phi = 0.3 (a solution mu
+ * times worse is accepted with probability phi at first).
+ * 
+ * The acceptance rate of each temperature is kept, to study the schedule.
+ */
+class SimulatedAnnealingMDD : public MHTrayectory {
+private:
+    CoolingSchedule schedule; // Esquema de enfriamiento
+    double alpha;             // Factor del esquema geométrico
+    double finalRatio;        // Temperatura final / temperatura inicial
+    
+    // Tasa de aceptación de cada temperatura, y total, de la última ejecución
+    std::vector<double> acceptanceRates;
+    double acceptanceRate;
+    
+public:
+    /**
+     * Constructor.
+     * 
+     * @param schedule Cooling schedule
+     * @param alpha Cooling factor of the geometric schedule, in (0, 1)
+     * @param finalRatio Final temperature, as a fraction of the initial one, in (0, 1)
+     */
+    SimulatedAnnealingMDD(CoolingSchedule schedule = CoolingSchedule::GEOMETRIC,
+                          double alpha = 0.95, double finalRatio = 1e-3);
+    
+    /**
+     * Destructor.
+     */
+    virtual ~SimulatedAnnealingMDD() {}
+    
+    using MHTrayectory::optimize;
+    
+    /**
+     * Run Simulated Annealing from a given solution.
+     * 
+     * @param problem The MDD problem to solve
+     * @param current The initial solution
+     * @param fitness The fitness of the initial solution
+     * @param maxevals Maximum number of evaluations
+     * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+     */
+    ResultMH optimize(Problem* problem, const tSolution& current,
+                      tFitness fitness, int maxevals) override;
+    
+    /**
+     * Returns the fraction of swaps accepted at each temperature of the
+     * last run.
+     */
+    const std::vector<double>& getAcceptanceRates() const { return acceptanceRates; }
+    
+    /**
+     * Returns the fraction of swaps accepted in the whole last run.
+     */
+    double getAcceptanceRate() const { return acceptanceRate; }
+    
+    /**
+     * Get the name of the algorithm.
+     * 
+     * @return The algorithm name, including the cooling schedule
+     */
+    std::string getName() const {
+        return schedule == CoolingSchedule::GEOMETRIC ? "SA-geometric" : "SA-LundyMees";
+    }
+};
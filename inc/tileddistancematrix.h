@@ -0,0 +1,188 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Symmetric matrix of distances kept on disk and read by square tiles.
+ *
+ * The matrix is split in TILE x TILE tiles and only the tiles on or above the
+ * diagonal are stored, one after the other in row-major order of tiles, in
+ * a file (see ProblemMDD::convertToTiledCache). Tiles are loaded on demand
+ * into a fixed-size cache with LRU replacement, so the matrix can be much
+ * larger than the available memory. Hits and misses of the cache are
+ * counted to measure how well the accesses fit in it.
+ *
+ * The cache is modified by const accesses, so one matrix must not be used by
+ * several threads at the same time.
+ */
+class TiledDistanceMatrix {
+public:
+    // Rows and columns of a tile (a tile of floats takes 256 KB)
+    static constexpr int TILE = 256;
+    // Memory used by default to cache tiles
+    static constexpr size_t DEFAULT_CACHE_BYTES = size_t(256) << 20;
+
+    /**
+     * View of a row that remembers the last tile used, so consecutive
+     * accesses to the same tile skip the cache lookup.
+     */
+    class Row {
+    public:
+        Row(const TiledDistanceMatrix& matrix, int i)
+            : matrix(matrix), i(i), lastColumn(-1), lastTile(nullptr), lastEpoch(0) {}
+
+        float operator[](int j) const {
+            int column = j / TILE;
+            // The tile is still valid if nothing has been evicted since
+            if (column != lastColumn || lastEpoch != matrix.epoch) {
+                lastTile = matrix.rowTile(i, column);
+                lastColumn = column;
+                lastEpoch = matrix.epoch;
+            }
+            return matrix.fromTile(lastTile, i, j);
+        }
+
+    private:
+        const TiledDistanceMatrix& matrix;
+        int i;
+        mutable int lastColumn;
+        mutable const float* lastTile;
+        mutable uint64_t lastEpoch;
+    };
+
+    /**
+     * Constructor of an empty matrix.
+     */
+    TiledDistanceMatrix();
+
+    /**
+     * Constructor that opens the tiles stored in a file.
+     *
+     * @param path The path to the file
+     * @param offset Position in the file of the first tile
+     * @param n Number of rows and columns
+     * @param cacheBytes Memory used to cache tiles
+     */
+    TiledDistanceMatrix(const std::string& path, size_t offset, int n, size_t cacheBytes);
+
+    TiledDistanceMatrix(TiledDistanceMatrix&& other) noexcept = default;
+    TiledDistanceMatrix& operator=(TiledDistanceMatrix&& other) noexcept = default;
+
+    /**
+     * Returns the element (i, j) = (j, i).
+     */
+    float operator()(int i, int j) const {
+        return fromTile(rowTile(i, j / TILE), i, j);
+    }
+
+    /**
+     * Returns a view of row i.
+     */
+    Row row(int i) const { return Row(*this, i); }
+
+    /**
+     * Copies row[columns[k]] into out[k], loading each tile needed only once
+     * (the columns are visited grouped by tile).
+     *
+     * @param i Row index
+     * @param columns Columns to read
+     * @param count Number of columns
+     * @param out Values read
+     */
+    void gatherRow(int i, const int* columns, int count, float* out) const;
+
+    /**
+     * Returns the number of rows (and columns) of the matrix.
+     */
+    int size() const { return n; }
+
+    /**
+     * Changes the memory used to cache tiles (the cache is emptied).
+     *
+     * @param cacheBytes Memory used to cache tiles (at least one tile)
+     */
+    void setCacheSize(size_t cacheBytes);
+
+    /**
+     * Returns the number of tile lookups found in the cache.
+     */
+    uint64_t getHits() const { return hits; }
+
+    /**
+     * Returns the number of tile lookups that had to read the file.
+     */
+    uint64_t getMisses() const { return misses; }
+
+    /**
+     * Resets the hit and miss counters.
+     */
+    void resetStats() const { hits = misses = 0; }
+
+    /**
+     * Returns the number of tiles per side of a matrix of n rows.
+     */
+    static int tilesPerSide(int n) { return (n + TILE - 1) / TILE; }
+
+    /**
+     * Returns the position of tile (ti, tj), ti <= tj, among the stored tiles.
+     */
+    static size_t tileIndex(int ti, int tj, int tiles) {
+        return static_cast<size_t>(ti) * tiles - static_cast<size_t>(ti) * (ti - 1) / 2 + (tj - ti);
+    }
+
+    /**
+     * Returns the number of bytes taken by the tiles of a matrix of n rows.
+     */
+    static size_t payloadSize(int n) {
+        size_t tiles = tilesPerSide(n);
+        return tiles * (tiles + 1) / 2 * TILE * TILE * sizeof(float);
+    }
+
+private:
+    // Tile holding (i, j) for some j in tile column `column`
+    const float* rowTile(int i, int column) const {
+        int ti = i / TILE;
+        return ti <= column ? tile(ti, column) : tile(column, ti);
+    }
+
+    // Element (i, j) from the tile that holds it (transposed below the diagonal)
+    static float fromTile(const float* data, int i, int j) {
+        int ti = i / TILE, tj = j / TILE;
+        return ti <= tj ? data[(i % TILE) * TILE + j % TILE]
+                        : data[(j % TILE) * TILE + i % TILE];
+    }
+
+    // Returns the tile (ti, tj), ti <= tj, reading it if it is not cached
+    const float* tile(int ti, int tj) const;
+
+    // Moves a slot to the front of the LRU list
+    void touch(int slot) const;
+
+    // Number of rows and columns, and of tiles per side
+    int n;
+    int tiles;
+    // File with the tiles and position of the first one
+    std::string path;
+    size_t offset;
+    std::unique_ptr<std::ifstream> file;
+
+    // Number of tiles that fit in the cache and storage for them
+    int capacity;
+    mutable std::vector<float> pool;
+    // Cached tile -> slot, and slot -> tile
+    mutable std::unordered_map<size_t, int> slotOf;
+    mutable std::vector<size_t> tileOf;
+    // LRU list of slots (most recent at head)
+    mutable std::vector<int> prev, next;
+    mutable int head, tail, used;
+    // Last tile found, to skip the lookup on repeated accesses
+    mutable size_t lastIndex;
+    mutable int lastSlot;
+    // Statistics, and number of evictions (invalidates remembered tiles)
+    mutable uint64_t hits, misses, epoch;
+};
@@ -9,42 +9,110 @@
 // All algorithms
 #include <randomsearchmdd.h>
 #include <greedymdd.h>
+#include <graspmdd.h>
+#include <ilsmdd.h>
 #include <localsearchmdd.h>
+#include <multistart.h>
+#include <simulatedannealingmdd.h>
 
 using namespace std;
 int main(int argc, char *argv[]) {
   // Verificar argumentos
   if (argc < 3) {
-    std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed>" << std::endl;
+    std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed> [dense|packed|tiled|coordinates]" << std::endl;
     return 1;
   }
 
   // Obtener argumentos
   std::string instance_path = argv[1];
   long int seed = atoi(argv[2]);
+  std::string storage_name = (argc > 3) ? argv[3] : "dense";
+  DistanceStorage storage = DistanceStorage::DENSE;
+  if (storage_name == "packed") {
+    storage = DistanceStorage::PACKED;
+  } else if (storage_name == "tiled") {
+    storage = DistanceStorage::TILED;
+  } else if (storage_name == "coordinates") {
+    // El fichero contiene las coordenadas de los puntos, no las distancias
+    storage = DistanceStorage::COORDINATES;
+  } else if (storage_name != "dense") {
+    std::cout << "Unknown storage: " << storage_name << std::endl;
+    return 1;
+  }
 
   // Inicializar generador de números aleatorios
   Random::seed(seed);
 
   // Cargar la instancia del problema
   cout << "Loading problem instance from: " << instance_path << endl;
-  ProblemMDD problem(instance_path);
+  ProblemMDD problem(instance_path, storage);
   
   cout << "Instance: " << problem.getInstanceName() << endl;
   cout << "n = " << problem.getN() << ", m = " << problem.getM() << endl;
+  cout << "Load time: " << problem.getLoadTime() << " seconds ("
+       << problem.getLoadThroughput() << " MB/s"
+       << (problem.isCached() ? ", binary cache" : "") << ")" << endl;
+
+  // Caché de fitness compartida por todos los algoritmos (16 MB)
+  problem.enableFitnessCache(1 << 20);
 
-  // Crear los algoritmos
-  RandomSearchMDD randomSearch;
+  // Crear los algoritmos. La búsqueda aleatoria comparte la caché de
+  // fitness, así que se ejecuta en un solo hilo: los valores no dependen del
+  // orden de las evaluaciones, pero los aciertos de la caché sí
+  RandomSearchMDD randomSearch(1);
   GreedyMDD greedy;
   LocalSearchMDD randLS(ExplorationStrategy::RANDOM);
   LocalSearchMDD heurLS(ExplorationStrategy::HEURISTIC);
+  LocalSearchMDD bestLS(ExplorationStrategy::BEST);
+  IteratedLocalSearchMDD ils;
+  SimulatedAnnealingMDD saGeometric(CoolingSchedule::GEOMETRIC);
+  SimulatedAnnealingMDD saLundyMees(CoolingSchedule::LUNDY_MEES);
 
   // Vector de algoritmos a ejecutar
   vector<pair<string, MH *>> algoritmos = {
     make_pair("RandomSearch", &randomSearch),
     make_pair("Greedy", &greedy),
     make_pair("randLS", &randLS),
-    make_pair("heurLS", &heurLS)
+    make_pair("heurLS", &heurLS),
+    make_pair("bestLS", &bestLS),
+    make_pair("ILS", &ils),
+    make_pair("SA-geometric", &saGeometric),
+    make_pair("SA-LundyMees", &saLundyMees)
+  };
+
+  // Mostrar el resultado de un algoritmo
+  auto mostrarResultado = [&](const ResultMH& result, double seconds) {
+    cout << "Best fitness: " << result.fitness << endl;
+    cout << "Evaluations: " << result.evaluations << endl;
+    cout << "Time: " << seconds << " seconds" << endl;
+    FitnessCache* cache = problem.getFitnessCache();
+    if (cache) {
+      cout << "Fitness cache: " << cache->getHits() << " hits, " << cache->getMisses()
+           << " misses (" << 100 * cache->hitRate() << "% hit rate)" << endl;
+      cache->resetStats();
+    }
+    if (storage == DistanceStorage::TILED) {
+      // Accesos a la caché de bloques acumulados hasta ahora
+      cout << "Tile hits: " << problem.getTileHits()
+           << ", misses: " << problem.getTileMisses() << endl;
+    }
+    if (storage == DistanceStorage::COORDINATES) {
+      // Filas de distancias servidas desde la caché, acumuladas hasta ahora
+      cout << "Row hits: " << problem.getRowHits()
+           << ", misses: " << problem.getRowMisses() << endl;
+    }
+    
+    // Mostrar solución
+    cout << "Best solution: [";
+    bool first = true;
+    for (size_t i = 0; i < result.solution.size(); i++) {
+      if (result.solution[i]) {
+        if (!first) cout << ", ";
+        cout << i;
+        first = false;
+      }
+    }
+    cout << "]" << endl;
   };
 
   // Ejecutar cada algoritmo
@@ -62,21 +130,30 @@ int main(int argc, char *argv[]) {
     timer.stop();
     
     // Mostrar resultados
-    cout << "Best fitness: " << result.fitness << endl;
-    cout << "Evaluations: " << result.evaluations << endl;
-    cout << "Time: " << timer.elapsed() << " seconds" << endl;
-    
-    // Mostrar solución
-    cout << "Best solution: [";
-    bool first = true;
-    for (size_t i = 0; i < result.solution.size(); i++) {
-      if (result.solution[i]) {
-        if (!first) cout << ", ";
-        cout << i;
-        first = false;
-      }
-    }
-    cout << "]" << endl;
+    mostrarResultado(result, timer.elapsed());
+  }
+
+  // Algoritmos paralelos (multiarranque de heurLS y GRASP), repartiendo las
+  // evaluaciones. Sin caché de fitness: al ser compartida por los hilos, el
+  // resultado dependería del orden en que evalúan (sin ella es el mismo con
+  // cualquier número de hilos)
+  problem.disableFitnessCache();
+  unsigned threads = problem.isThreadSafe() ? 0 : 1;
+  MultiStart multiLS([]() { return unique_ptr<MH>(new LocalSearchMDD(ExplorationStrategy::HEURISTIC, false)); },
+                     16, threads);
+  GraspMDD grasp(0.3, 16, ExplorationStrategy::HEURISTIC, threads);
+  vector<pair<string, MH *>> paralelos = {
+    make_pair("MultiStart-heurLS", &multiLS),
+    make_pair("GRASP", &grasp)
+  };
+  for (auto& alg : paralelos) {
+    Random::seed(seed);
+    cout << "\n=== " << alg.first << " ===" << endl;
+    Timer timer;
+    timer.start();
+    ResultMH result = alg.second->optimize(&problem, 100000);
+    timer.stop();
+    mostrarResultado(result, timer.elapsed());
   }
 
   return 0;
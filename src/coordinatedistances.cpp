@@ -0,0 +1,65 @@
+#include <coordinatedistances.h>
+#include <algorithm>
+
+// Constructor: empty oracle
+CoordinateDistanceOracle::CoordinateDistanceOracle()
+    : n(0), dimensions(0), stride(0), capacity(0), clock(0), hits(0), misses(0) {}
+
+// Constructor: n points with all their coordinates set to zero
+CoordinateDistanceOracle::CoordinateDistanceOracle(int n, int dimensions, size_t cacheBytes)
+    : CoordinateDistanceOracle() {
+    this->n = n;
+    this->dimensions = dimensions;
+    // Padding with zeros does not change the distances
+    stride = (dimensions + 7) / 8 * 8;
+    coordinates.assign(static_cast<size_t>(n) * stride, 0.0f);
+    setCacheSize(cacheBytes);
+}
+
+// Resize (and empty) the cache of rows
+void CoordinateDistanceOracle::setCacheSize(size_t cacheBytes) {
+    size_t rowBytes = std::max<size_t>(1, static_cast<size_t>(n) * sizeof(float));
+    size_t rows = std::min<size_t>(n, cacheBytes / rowBytes);
+    // Two rows at least, so that the views of the last two stay valid
+    capacity = (cacheBytes == 0 || n == 0) ? 0 : static_cast<int>(std::max<size_t>(2, rows));
+
+    pool.assign(static_cast<size_t>(capacity) * n, 0.0f);
+    slotOf.assign(n, -1);
+    rowOf.assign(capacity, -1);
+    lastUse.assign(capacity, 0);
+    requests.assign(n, 0);
+}
+
+// Return a view of a row, caching it if it has been requested before
+CoordinateDistanceOracle::Row CoordinateDistanceOracle::row(int i) const {
+    if (capacity == 0) {
+        return Row(*this, i, nullptr); // Nothing is modified without cache
+    }
+    int slot = slotOf[i];
+    if (slot >= 0) {
+        hits++;
+        lastUse[slot] = ++clock;
+        return Row(*this, i, pool.data() + static_cast<size_t>(slot) * n);
+    }
+
+    misses++;
+    if (++requests[i] < ADMIT_AFTER) {
+        return Row(*this, i, nullptr); // Computed on each access
+    }
+
+    // Take a free slot or the least recently used one
+    slot = static_cast<int>(std::min_element(lastUse.begin(), lastUse.end()) - lastUse.begin());
+    if (rowOf[slot] >= 0) {
+        slotOf[rowOf[slot]] = -1;
+    }
+    rowOf[slot] = i;
+    slotOf[i] = slot;
+    requests[i] = 0;
+    lastUse[slot] = ++clock;
+
+    float* values = pool.data() + static_cast<size_t>(slot) * n;
+    for (int j = 0; j < n; j++) {
+        values[j] = compute(i, j);
+    }
+    return Row(*this, i, values);
+}
@@ -0,0 +1,88 @@
+#include <distancematrix.h>
+#include <algorithm>
+#include <utility>
+
+// Allocates n x stride zeroed floats aligned to DistanceMatrix::ALIGNMENT
+static float* allocateAligned(size_t count) {
+    float* ptr = static_cast<float*>(
+        ::operator new[](count * sizeof(float), std::align_val_t(DistanceMatrix::ALIGNMENT)));
+    std::fill(ptr, ptr + count, 0.0f);
+    return ptr;
+}
+
+// Constructor: n x n matrix of zeros with every row padded to a cache line
+DistanceMatrix::DistanceMatrix(int n) : n(n), stride(paddedStride(n)) {
+    data.reset(allocateAligned(static_cast<size_t>(n) * stride));
+    base = data.get();
+}
+
+// View of an external matrix (not owned)
+DistanceMatrix DistanceMatrix::view(int n, const float* external) {
+    DistanceMatrix matrix;
+    matrix.n = n;
+    matrix.stride = paddedStride(n);
+    matrix.base = const_cast<float*>(external);
+    return matrix;
+}
+
+// Copy constructor: deep copy of the storage (also of a view)
+DistanceMatrix::DistanceMatrix(const DistanceMatrix& other)
+    : n(other.n), stride(other.stride), base(nullptr) {
+    size_t count = static_cast<size_t>(n) * stride;
+    if (count > 0) {
+        data.reset(allocateAligned(count));
+        std::copy(other.base, other.base + count, data.get());
+        base = data.get();
+    }
+}
+
+// Copy assignment
+DistanceMatrix& DistanceMatrix::operator=(const DistanceMatrix& other) {
+    if (this != &other) {
+        DistanceMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Constructor: n x n symmetric matrix of zeros, storing the upper triangle
+PackedDistanceMatrix::PackedDistanceMatrix(int n) : n(n), data(packedSize(n), 0.0f) {
+    base = data.data();
+    computeRowBase();
+}
+
+// View of an external packed matrix (not owned)
+PackedDistanceMatrix PackedDistanceMatrix::view(int n, const float* external) {
+    PackedDistanceMatrix matrix;
+    matrix.n = n;
+    matrix.base = const_cast<float*>(external);
+    matrix.computeRowBase();
+    return matrix;
+}
+
+// Copy constructor: deep copy of the storage (also of a view)
+PackedDistanceMatrix::PackedDistanceMatrix(const PackedDistanceMatrix& other)
+    : n(other.n), rowBase(other.rowBase) {
+    data.assign(other.base, other.base + packedSize(n));
+    base = data.data();
+}
+
+// Copy assignment
+PackedDistanceMatrix& PackedDistanceMatrix::operator=(const PackedDistanceMatrix& other) {
+    if (this != &other) {
+        PackedDistanceMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Offsets of the rows in the packed storage
+void PackedDistanceMatrix::computeRowBase() {
+    rowBase.resize(n);
+    size_t start = 0;
+    for (int i = 0; i < n; i++) {
+        // Row i holds the n - i elements (i, i), ..., (i, n-1)
+        rowBase[i] = start - i;
+        start += n - i;
+    }
+}
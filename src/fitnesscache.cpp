@@ -0,0 +1,54 @@
+#include <fitnesscache.h>
+#include <cstring>
+
+// Flag of the data word marking an exact value
+static const uint64_t EXACT_FLAG = uint64_t(1) << 32;
+// Flag of the data word marking a used entry, so that an empty entry
+// (all zeros) never matches the key 0
+static const uint64_t USED_FLAG = uint64_t(1) << 33;
+
+// Constructor: table of a power of two entries, all empty
+FitnessCache::FitnessCache(size_t entries) : hits(0), misses(0) {
+    size_t size = 1;
+    while (size < entries) size <<= 1;
+    this->entries.reset(new Entry[size]);
+    mask = size - 1;
+    clear();
+}
+
+// Look up a key: it matches only if both words come from the same write
+bool FitnessCache::lookup(uint64_t key, tFitness& value, bool& exact) const {
+    const Entry& entry = entries[key & mask];
+    uint64_t data = entry.data.load(std::memory_order_relaxed);
+    uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((data & USED_FLAG) == 0 || (data ^ check) != key) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t bits = static_cast<uint32_t>(data);
+    std::memcpy(&value, &bits, sizeof(value));
+    exact = (data & EXACT_FLAG) != 0;
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Store a value, replacing the entry of its key
+void FitnessCache::store(uint64_t key, tFitness value, bool exact) {
+    static_assert(sizeof(tFitness) == sizeof(uint32_t), "The fitness must take 32 bits");
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint64_t data = bits | USED_FLAG | (exact ? EXACT_FLAG : 0);
+
+    Entry& entry = entries[key & mask];
+    entry.data.store(data, std::memory_order_relaxed);
+    entry.check.store(data ^ key, std::memory_order_relaxed);
+}
+
+// Empty every entry
+void FitnessCache::clear() {
+    for (size_t i = 0; i <= mask; i++) {
+        entries[i].data.store(0, std::memory_order_relaxed);
+        entries[i].check.store(0, std::memory_order_relaxed);
+    }
+}
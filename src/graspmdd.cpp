@@ -0,0 +1,152 @@
+#include <graspmdd.h>
+#include <greedymdd.h>
+#include <parallel.h>
+#include <problemmdd.h>
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Constructor
+GraspMDD::GraspMDD(double alpha, int iterations, ExplorationStrategy strategy, unsigned threads)
+    : MH(), alpha(alpha), iterations(iterations), strategy(strategy), threads(threads) {
+    if (alpha < 0.0 || alpha > 1.0) {
+        throw std::runtime_error("Error: alpha must be in [0, 1]");
+    }
+    if (iterations <= 0) {
+        throw std::runtime_error("Error: the number of iterations must be positive");
+    }
+}
+
+// Build a randomized greedy solution from the restricted candidate list
+tSolution GraspMDD::constructSolution(const ProblemMDD& problem, int& evaluations) const {
+    const int n = problem.getN();
+    const int m = problem.getM();
+    
+    SelectionSums<ProblemMDD> sums(problem);
+    sums.add(Random::get<int>(0, n - 1));
+    
+    // Dispersión de cada candidato en el paso actual
+    std::vector<int> candidates;
+    std::vector<float> dispersions;
+    candidates.reserve(n);
+    dispersions.reserve(n);
+    
+    for (int iter = 1; iter < m; iter++) {
+        // Evaluamos todos los candidatos (O(n·m)), sin corte: la lista
+        // restringida necesita los valores exactos
+        candidates.clear();
+        dispersions.clear();
+        float minDisp = std::numeric_limits<float>::max();
+        float maxDisp = std::numeric_limits<float>::lowest();
+        for (int candidate = 0; candidate < n; candidate++) {
+            if (sums.isSelected(candidate)) {
+                continue;
+            }
+            float dispersion = sums.dispersionWith(candidate);
+            evaluations++;
+            candidates.push_back(candidate);
+            dispersions.push_back(dispersion);
+            minDisp = std::min(minDisp, dispersion);
+            maxDisp = std::max(maxDisp, dispersion);
+        }
+        
+        // Lista restringida: los candidatos por debajo del umbral, que se
+        // compactan al principio del vector
+        const double threshold = minDisp + alpha * (maxDisp - minDisp);
+        size_t size = 0;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (dispersions[i] <= threshold) {
+                candidates[size++] = candidates[i];
+            }
+        }
+        
+        // Añadimos uno de ellos al azar
+        sums.add(candidates[Random::get<size_t>(0, size - 1)]);
+    }
+    
+    return sums.getSolution();
+}
+
+/**
+ * Run GRASP.
+ * 
+ * @param problem The MDD problem to solve
+ * @param maxevals Maximum number of evaluations of all the iterations together
+ * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+ */
+ResultMH GraspMDD::optimize(Problem* problem, int maxevals) {
+    // Comprobamos que es un problema MDD
+    ProblemMDD* mddProblem = dynamic_cast<ProblemMDD*>(problem);
+    assert(mddProblem != nullptr);
+    
+    Timer timer;
+    timer.start();
+    
+    // Semilla base, de la que se deriva la de cada iteración
+    const uint64_t seed = Random::get<uint64_t>();
+    
+    // Evaluaciones de una construcción (los candidatos de cada paso), más
+    // la de la solución construida al empezar la búsqueda local
+    const int n = mddProblem->getN();
+    const int m = mddProblem->getM();
+    const int constructionEvals = (m - 1) * n - m * (m - 1) / 2;
+    
+    // Iteraciones que caben en el presupuesto, y reparto de este entre
+    // ellas, sin pasarse del total
+    const int runs = std::min(iterations, maxevals / (constructionEvals + 1));
+    if (runs <= 0) {
+        throw std::runtime_error("Error: the budget does not allow a single GRASP construction");
+    }
+    std::vector<int> budgets(runs, maxevals / runs);
+    for (int k = 0; k < maxevals % runs; k++) {
+        budgets[k]++;
+    }
+    
+    // Mejor solución compartida por todas las iteraciones; a igualdad de
+    // fitness gana la de menor índice, así que no depende del orden
+    std::mutex bestMutex;
+    tSolution bestSolution;
+    tFitness bestFitness = std::numeric_limits<tFitness>::max();
+    int bestIteration = -1;
+    std::vector<unsigned> evaluations(runs, 0);
+    
+    parallel::parallelFor(runs, threads, [&](size_t k) {
+        // Flujo aleatorio propio de la iteración (el del hilo se restaura)
+        parallel::ScopedRandomStream stream(parallel::streamSeed(seed, k));
+        
+        // Construcción aleatorizada y búsqueda local desde ella, con el
+        // presupuesto que deja la construcción
+        int used = 0;
+        tSolution initial = constructSolution(*mddProblem, used);
+        LocalSearchMDD localSearch(strategy, false);
+        ResultMH result = localSearch.search(*mddProblem, budgets[k] - used, std::move(initial));
+        evaluations[k] = used + result.evaluations;
+        
+        {
+            std::lock_guard<std::mutex> lock(bestMutex);
+            if (result.fitness < bestFitness ||
+                (result.fitness == bestFitness && static_cast<int>(k) < bestIteration)) {
+                bestSolution = result.solution;
+                bestFitness = result.fitness;
+                bestIteration = static_cast<int>(k);
+            }
+        }
+    });
+    
+    unsigned totalEvaluations = 0;
+    for (unsigned e : evaluations) {
+        totalEvaluations += e;
+    }
+    
+    timer.stop();
+    std::cout << "\n" << getName() << " (alpha = " << alpha << "): " << runs
+              << " iteraciones completadas en " << std::fixed << std::setprecision(2)
+              << timer.elapsed() << " segundos (mejor: iteración " << bestIteration << ")" << std::endl;
+    
+    return ResultMH(bestSolution, bestFitness, totalEvaluations);
+}
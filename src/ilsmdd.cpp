@@ -0,0 +1,93 @@
+#include <ilsmdd.h>
+#include <problemmdd.h>
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * Run Iterated Local Search.
+ * 
+ * @param problem The MDD problem to solve
+ * @param maxevals Maximum number of evaluations of the whole run
+ * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+ */
+ResultMH IteratedLocalSearchMDD::optimize(Problem* problem, int maxevals) {
+    // Comprobamos que es un problema MDD
+    ProblemMDD* mddProblem = dynamic_cast<ProblemMDD*>(problem);
+    assert(mddProblem != nullptr);
+    
+    Timer timer;
+    timer.start();
+    
+    const int m = mddProblem->getM();
+    const int numNonSelected = mddProblem->getN() - m;
+    const int k = perturbationSize > 0 ? perturbationSize : std::max(1, m / 10);
+    
+    // Solución inicial aleatoria, su información de factorización (la única
+    // vez que se construye) y el primer óptimo local
+    tSolution currentSolution = mddProblem->createSolution();
+    double currentFitness = mddProblem->fitness(currentSolution);
+    int evaluations = 1;
+    ProblemMDD::InfoHandle info = mddProblem->makeFactoringInfo(MDDSubset(currentSolution));
+    
+    // Descenso hasta un óptimo local, reservando una evaluación para su
+    // fitness exacto (sin el redondeo acumulado de las sumas actualizadas en
+    // cada intercambio), que es con el que se comparan los óptimos
+    LocalSearchMDD localSearch(strategy, false);
+    auto descend = [&]() {
+        evaluations += localSearch.improve(*mddProblem, *info, currentSolution, currentFitness,
+                                           maxevals - evaluations - 1);
+        currentFitness = mddProblem->fitness(currentSolution);
+        evaluations++;
+    };
+    descend();
+    
+    // Mejor óptimo encontrado, con su información (copiada, no reconstruida)
+    tSolution bestSolution = currentSolution;
+    double bestFitness = currentFitness;
+    ProblemMDD::InfoHandle bestInfo(new MDDSolutionInfo(*info));
+    
+    int restarts = 0;
+    // Cada reinicio necesita al menos la evaluación de la perturbación y la
+    // del fitness exacto
+    while (maxevals - evaluations >= 2 && numNonSelected > 0) {
+        // Perturbación: k intercambios aleatorios aplicados a la información
+        for (int s = 0; s < k; s++) {
+            int selectedIdx = Random::get<int>(0, m - 1);
+            int nonSelectedIdx = Random::get<int>(0, numNonSelected - 1);
+            currentSolution[info->selected[selectedIdx]] = false;
+            currentSolution[info->nonSelected[nonSelectedIdx]] = true;
+            mddProblem->applySwap(*info, selectedIdx, nonSelectedIdx);
+        }
+        
+        // El fitness de la solución perturbada sale de sus sumas, ya actualizadas
+        currentFitness = info->sumDistances[info->maxSlot] - info->sumDistances[info->minSlot];
+        evaluations++;
+        
+        // Nuevo descenso con las evaluaciones que quedan
+        descend();
+        restarts++;
+        
+        // Criterio de aceptación: seguimos desde el mejor óptimo
+        if (currentFitness < bestFitness) {
+            bestSolution = currentSolution;
+            bestFitness = currentFitness;
+            *bestInfo = *info;
+            
+            std::cout << "ILS: Mejora en el reinicio " << restarts
+                      << " (nuevo fitness: " << bestFitness << ")" << std::endl;
+        } else {
+            currentSolution = bestSolution;
+            *info = *bestInfo;
+        }
+    }
+    
+    timer.stop();
+    std::cout << "\nILS completado en " << std::fixed << std::setprecision(2)
+              << timer.elapsed() << " segundos (" << restarts << " reinicios)." << std::endl;
+    std::cout << "Fitness final: " << bestFitness << std::endl;
+    std::cout << "Evaluaciones: " << evaluations << std::endl;
+    
+    return ResultMH(bestSolution, bestFitness, evaluations);
+}
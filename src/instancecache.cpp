@@ -0,0 +1,74 @@
+#include <instancecache.h>
+#include <mappedfile.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// Replace the extension of a path (or append one if it has none)
+static std::string replaceExtension(const std::string& filename, const std::string& extension) {
+    size_t lastSlash = filename.find_last_of("/\\");
+    size_t lastDot = filename.find_last_of(".");
+    if (lastDot == std::string::npos ||
+        (lastSlash != std::string::npos && lastDot < lastSlash)) {
+        return filename + extension;
+    }
+    return filename.substr(0, lastDot) + extension;
+}
+
+// Replace the extension of the instance by .mddc
+std::string instanceCachePath(const std::string& filename) {
+    return replaceExtension(filename, ".mddc");
+}
+
+// Replace the extension of the instance by .mddt
+std::string tiledCachePath(const std::string& filename) {
+    return replaceExtension(filename, ".mddt");
+}
+
+// FNV-1a applied to 64-bit words (and to the remaining bytes one by one)
+uint64_t instanceChecksum(const void* data, size_t bytes) {
+    const uint64_t PRIME = 1099511628211ULL;
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+
+    size_t words = bytes / sizeof(uint64_t);
+    for (size_t k = 0; k < words; k++) {
+        uint64_t word;
+        std::memcpy(&word, p + k * sizeof(uint64_t), sizeof(uint64_t));
+        hash = (hash ^ word) * PRIME;
+    }
+    for (size_t k = words * sizeof(uint64_t); k < bytes; k++) {
+        hash = (hash ^ p[k]) * PRIME;
+    }
+    return hash;
+}
+
+// Size and modification time of the text, or zeros if it does not exist
+bool instanceTextStamp(const std::string& textPath, uint64_t& size, int64_t& time) {
+    size = 0;
+    time = 0;
+    std::error_code error;
+    auto fileSize = std::filesystem::file_size(textPath, error);
+    if (error) {
+        return false;
+    }
+    auto fileTime = std::filesystem::last_write_time(textPath, error);
+    if (error) {
+        return false;
+    }
+    size = fileSize;
+    time = fileTime.time_since_epoch().count();
+    return true;
+}
+
+// Size and checksum of the text, or zeros if it cannot be opened
+bool instanceTextFingerprint(const std::string& textPath, uint64_t& size, uint64_t& hash) {
+    size = hash = 0;
+    if (!std::ifstream(textPath).good()) {
+        return false;
+    }
+    MappedFile text(textPath);
+    size = text.size();
+    hash = instanceChecksum(text.begin(), text.size());
+    return true;
+}
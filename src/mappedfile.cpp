@@ -0,0 +1,67 @@
+#include <mappedfile.h>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Constructor: map the whole file read-only
+MappedFile::MappedFile(const std::string& filename)
+    : data(nullptr), length(0), mapped(false) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Error: Could not open file " + filename);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Error: Could not read size of file " + filename);
+    }
+    length = info.st_size;
+
+    if (length > 0) {
+        void* ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Error: Could not map file " + filename);
+        }
+        // The file is read sequentially from start to end
+        madvise(ptr, length, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(ptr);
+        mapped = true;
+    }
+    close(fd);
+}
+
+// Destructor: unmap the file
+MappedFile::~MappedFile() {
+    if (mapped) {
+        munmap(const_cast<char*>(data), length);
+    }
+}
+
+#else
+#include <fstream>
+
+// Constructor: without mmap, read the whole file into memory
+MappedFile::MappedFile(const std::string& filename)
+    : data(nullptr), length(0), mapped(false) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error: Could not open file " + filename);
+    }
+    length = file.tellg();
+    char* buffer = new char[length];
+    file.seekg(0);
+    file.read(buffer, length);
+    data = buffer;
+}
+
+// Destructor: release the buffer
+MappedFile::~MappedFile() {
+    delete[] data;
+}
+#endif
@@ -0,0 +1,43 @@
+#include <mddsubset.h>
+
+// Constructor: elements in order, the first m selected
+MDDSubset::MDDSubset(int n, int m) : partition(n), position(n), m(m) {
+    for (int i = 0; i < n; i++) {
+        partition[i] = i;
+        position[i] = i;
+    }
+}
+
+// Restore the initial partition
+void MDDSubset::reset() {
+    for (int i = 0; i < size(); i++) {
+        partition[i] = i;
+        position[i] = i;
+    }
+}
+
+// Constructor from a binary solution: selected elements first
+MDDSubset::MDDSubset(const tSolution& solution)
+    : partition(solution.size()), position(solution.size()), m(0) {
+    int n = solution.size();
+    for (int i = 0; i < n; i++) {
+        if (solution[i]) m++;
+    }
+
+    int nextSelected = 0;
+    int nextNonSelected = m;
+    for (int i = 0; i < n; i++) {
+        int pos = solution[i] ? nextSelected++ : nextNonSelected++;
+        partition[pos] = i;
+        position[i] = pos;
+    }
+}
+
+// Convert into a binary solution
+tSolution MDDSubset::toSolution() const {
+    tSolution solution(partition.size(), false);
+    for (int i = 0; i < m; i++) {
+        solution[partition[i]] = true;
+    }
+    return solution;
+}
@@ -0,0 +1,79 @@
+#include <multistart.h>
+#include <parallel.h>
+#include <timer.h>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Constructor
+MultiStart::MultiStart(Factory factory, int starts, unsigned threads)
+    : MH(), factory(std::move(factory)), starts(starts), threads(threads) {
+    if (starts <= 0) {
+        throw std::runtime_error("Error: the number of starts must be positive");
+    }
+}
+
+/**
+ * Run every start and return the best result.
+ * 
+ * @param problem The problem to solve (shared by every start)
+ * @param maxevals Maximum number of evaluations of all the starts together
+ * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+ */
+ResultMH MultiStart::optimize(Problem* problem, int maxevals) {
+    Timer timer;
+    timer.start();
+    
+    // Semilla base tomada del Random del hilo que llama, de la que se deriva
+    // la de cada arranque
+    const uint64_t seed = Random::get<uint64_t>();
+    
+    // Reparto del presupuesto: los primeros arranques reciben el resto
+    std::vector<int> budgets(starts, maxevals / starts);
+    for (int k = 0; k < maxevals % starts; k++) {
+        budgets[k]++;
+    }
+    
+    // Resultado de cada arranque, en su propia posición
+    std::vector<tSolution> solutions(starts);
+    std::vector<tFitness> fitnesses(starts);
+    std::vector<unsigned> evaluations(starts, 0);
+    
+    parallel::parallelFor(starts, threads, [&](size_t k) {
+        if (budgets[k] <= 0) {
+            return;
+        }
+        
+        // Cada arranque usa su propio flujo aleatorio; el estado del Random
+        // del hilo se restaura al terminar, para que el del hilo que llama
+        // no dependa de si ha ejecutado arranques o no
+        parallel::ScopedRandomStream stream(parallel::streamSeed(seed, k));
+        
+        std::unique_ptr<MH> mh = factory();
+        ResultMH result = mh->optimize(problem, budgets[k]);
+        solutions[k] = result.solution;
+        fitnesses[k] = result.fitness;
+        evaluations[k] = result.evaluations;
+    });
+    
+    // Reducción determinista: el mejor fitness y, a igualdad, el menor índice
+    int best = -1;
+    unsigned totalEvaluations = 0;
+    for (int k = 0; k < starts; k++) {
+        totalEvaluations += evaluations[k];
+        if (!solutions[k].empty() && (best < 0 || fitnesses[k] < fitnesses[best])) {
+            best = k;
+        }
+    }
+    if (best < 0) {
+        throw std::runtime_error("Error: the evaluation budget is too small for a start");
+    }
+    
+    timer.stop();
+    std::cout << "\n" << getName() << ": " << starts << " arranques completados en "
+              << std::fixed << std::setprecision(2) << timer.elapsed()
+              << " segundos (mejor: arranque " << best << ")" << std::endl;
+    
+    return ResultMH(solutions[best], fitnesses[best], totalEvaluations);
+}
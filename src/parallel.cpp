@@ -0,0 +1,51 @@
+#include <parallel.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+// One thread per hardware thread (hardware_concurrency may return 0)
+unsigned defaultThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Run the tasks, each thread taking the next free index
+void parallelFor(size_t count, unsigned threads, const std::function<void(size_t)>& body) {
+    if (threads == 0) {
+        threads = defaultThreads();
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            body(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                try {
+                    body(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+} // namespace parallel
@@ -1,20 +1,114 @@
 #include <problemmdd.h>
+#include <simdkernels.h>
 #include <random.hpp>
+#include <instancecache.h>
+#include <mappedfile.h>
+#include <parallel.h>
+#include <timer.h>
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <limits>
-#include <sstream>
 #include <stdexcept>
+#include <thread>
 
-// Constructor: loads problem data from file
-ProblemMDD::ProblemMDD(const std::string& filename) : Problem() {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Error: Could not open file " + filename);
+// Powers of ten that are exact in double precision
+static const double POWERS_OF_TEN[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Skip spaces, tabs and line breaks
+static const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    return p;
+}
+
+// Parse a (possibly negative) integer; returns nullptr if there is none
+static const char* parseInt(const char* p, const char* end, long& value) {
+    bool negative = (p < end && *p == '-');
+    if (negative) p++;
+    if (p == end || *p < '0' || *p > '9') return nullptr;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
     }
+    if (negative) value = -value;
+    return p;
+}
 
-    // Set instance name from filename (remove path and extension)
+// Parse a decimal number (with optional fraction and exponent) without
+// locale handling; returns nullptr if there is none
+static const char* parseFloat(const char* p, const char* end, float& value) {
+    bool negative = (p < end && *p == '-');
+    if (p < end && (*p == '-' || *p == '+')) p++;
+    
+    // Significant digits are accumulated exactly in an integer
+    unsigned long long mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool any = false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++, any = true) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++; // Integer digits beyond the precision only scale
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, any = true) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!any) return nullptr;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        long expValue;
+        const char* q = p + 1;
+        if (q < end && *q == '+') q++;
+        q = parseInt(q, end, expValue);
+        if (q == nullptr) return nullptr;
+        exponent += expValue;
+        p = q;
+    }
+    
+    // A single multiplication/division by an exact power of ten is correctly
+    // rounded; larger exponents (not found in the instances) use pow
+    double result = static_cast<double>(mantissa);
+    if (exponent >= 0 && exponent <= 22) {
+        result *= POWERS_OF_TEN[exponent];
+    } else if (exponent < 0 && exponent >= -22) {
+        result /= POWERS_OF_TEN[-exponent];
+    } else {
+        result *= std::pow(10.0, exponent);
+    }
+    value = static_cast<float>(negative ? -result : result);
+    return p;
+}
+
+// Parse the first line of an instance (n and m); returns the next byte
+static const char* parseSizes(const char* begin, const char* end, int& n, int& m) {
+    long valueN = 0, valueM = 0;
+    const char* p = parseInt(skipSpaces(begin, end), end, valueN);
+    if (p) p = parseInt(skipSpaces(p, end), end, valueM);
+    if (p == nullptr || valueN <= 0 || valueM <= 0 || valueM >= valueN ||
+        valueN > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Error: Invalid n or m values in file");
+    }
+    n = valueN;
+    m = valueM;
+    return p;
+}
+
+// Name of an instance: its file name without path and extension
+static std::string instanceNameOf(const std::string& filename) {
     size_t lastSlash = filename.find_last_of("/\\");
     size_t lastDot = filename.find_last_of(".");
     if (lastSlash == std::string::npos) {
@@ -24,32 +118,440 @@ ProblemMDD::ProblemMDD(const std::string& filename) : Problem() {
     }
     
     if (lastDot == std::string::npos || lastDot < lastSlash) {
-        instanceName = filename.substr(lastSlash);
+        return filename.substr(lastSlash);
+    }
+    return filename.substr(lastSlash, lastDot - lastSlash);
+}
+
+// Constructor: loads problem data from file (or from its binary cache)
+ProblemMDD::ProblemMDD(const std::string& filename, DistanceStorage storage,
+                       int loadThreads)
+    : Problem(), storage(storage), cached(false) {
+    Timer timer;
+    timer.start();
+
+    // Set instance name from filename (remove path and extension)
+    instanceName = instanceNameOf(filename);
+
+    if (storage == DistanceStorage::TILED) {
+        // Tiles are always read from the tiled cache, created if needed
+        std::string cachePath = tiledCachePath(filename);
+        cached = loadTiledCache(cachePath, filename);
+        if (!cached) {
+            convertToTiledCache(filename, cachePath);
+            if (!loadTiledCache(cachePath, filename)) {
+                throw std::runtime_error("Error: Could not open tiled cache " + cachePath);
+            }
+        }
+    } else if (storage == DistanceStorage::COORDINATES) {
+        loadCoordinates(filename);
     } else {
-        instanceName = filename.substr(lastSlash, lastDot - lastSlash);
+        // Use the binary cache if there is a valid one, else parse the text
+        cached = loadCache(instanceCachePath(filename), filename);
+        if (!cached) {
+            loadText(filename, loadThreads);
+        }
+    }
+    
+    // Zobrist keys from a fixed generator (splitmix64), so hashes do not
+    // depend on the seed and do not consume numbers from Random
+    zobristKeys.resize(n);
+    parallel::CounterEngine keys(0);
+    for (int i = 0; i < n; i++) {
+        zobristKeys[i] = keys();
     }
+    
+    timer.stop();
+    loadSeconds = timer.elapsed();
+}
+
+// Load the instance from its text file
+void ProblemMDD::loadText(const std::string& filename, int loadThreads) {
+    // Map the file: it is parsed in place, without copies or streams
+    MappedFile file(filename);
 
     // Read first line: n and m
-    file >> n >> m;
-    if (n <= 0 || m <= 0 || m >= n) {
-        throw std::runtime_error("Error: Invalid n or m values in file");
+    const char* p = parseSizes(file.begin(), file.end(), n, m);
+
+    // Initialize distance matrix with zeros, in the requested layout
+    if (storage == DistanceStorage::PACKED) {
+        packedDistances = PackedDistanceMatrix(n);
+    } else {
+        distances = DistanceMatrix(n);
     }
 
-    // Initialize distance matrix with zeros
-    distances.resize(n, std::vector<float>(n, 0.0f));
+    // Read distance data (only upper triangular part), splitting the rest of
+    // the file in byte ranges that start at a new line, one per thread. Every
+    // pair appears once, so the threads write disjoint entries
+    if (loadThreads < 1) loadThreads = 1;
+    std::vector<const char*> bounds(loadThreads + 1);
+    size_t chunk = (file.end() - p) / loadThreads;
+    bounds[0] = p;
+    for (int t = 1; t < loadThreads; t++) {
+        const char* q = std::max(bounds[t - 1], p + t * chunk);
+        while (q < file.end() && *q != '\n') q++;
+        bounds[t] = q;
+    }
+    bounds[loadThreads] = file.end();
+    
+    if (loadThreads == 1) {
+        parseDistances(bounds[0], bounds[1]);
+    } else {
+        std::vector<std::thread> workers;
+        std::vector<std::exception_ptr> errors(loadThreads);
+        for (int t = 0; t < loadThreads; t++) {
+            workers.emplace_back([&, t]() {
+                try {
+                    parseDistances(bounds[t], bounds[t + 1]);
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (auto& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+    
+    loadBytes = file.size();
+}
 
-    // Read distance data (only upper triangular part)
-    int i, j;
-    float dist;
-    while (file >> i >> j >> dist) {
-        if (i < 0 || i >= n || j < 0 || j >= n) {
-            throw std::runtime_error("Error: Invalid indices in distance matrix");
+// Load the points of an instance given by coordinates
+void ProblemMDD::loadCoordinates(const std::string& filename) {
+    MappedFile file(filename);
+
+    // Read first line: n, m and the number of coordinates
+    long dimensions = 0;
+    const char* p = parseSizes(file.begin(), file.end(), n, m);
+    p = parseInt(skipSpaces(p, file.end()), file.end(), dimensions);
+    if (p == nullptr || dimensions <= 0) {
+        throw std::runtime_error("Error: Invalid number of coordinates in file");
+    }
+
+    coordinateDistances = CoordinateDistanceOracle(n, dimensions);
+    for (int i = 0; i < n; i++) {
+        float* point = coordinateDistances.point(i);
+        for (long k = 0; k < dimensions; k++) {
+            p = parseFloat(skipSpaces(p, file.end()), file.end(), point[k]);
+            if (p == nullptr) {
+                throw std::runtime_error("Error: Missing coordinates in file");
+            }
+        }
+    }
+
+    loadBytes = file.size();
+}
+
+// Check that a cache was created from this instance: same name and, when
+// the text file is there, the same size and modification time or (with
+// checkContents, reading the whole text) the same size and contents
+static bool matchesInstance(const InstanceCacheHeader& header, const std::string& name,
+                            const std::string& textPath, bool checkContents) {
+    // The name is stored truncated to the size of the field
+    if (std::strncmp(header.name, name.c_str(), sizeof(header.name) - 1) != 0) {
+        return false;
+    }
+    if (checkContents) {
+        uint64_t textSize, textHash;
+        if (!instanceTextFingerprint(textPath, textSize, textHash)) {
+            return true; // A cache without its text is used as is
+        }
+        return header.textSize == textSize && header.textHash == textHash;
+    }
+    uint64_t textSize;
+    int64_t textTime;
+    if (!instanceTextStamp(textPath, textSize, textTime)) {
+        return true;
+    }
+    return header.textSize == textSize && header.textTime == textTime;
+}
+
+// Replace a file by the temporary one just written: a problem that maps the
+// old file keeps its contents, and a failed write never leaves a partial file
+static void replaceWithTemporary(const std::string& tmpPath, const std::string& path) {
+    std::error_code error;
+    std::filesystem::rename(tmpPath, path, error);
+    if (error) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Error: Could not replace cache file " + path);
+    }
+}
+
+// Map the binary cache and use its distances in place
+bool ProblemMDD::loadCache(const std::string& cachePath, const std::string& textPath) {
+    if (!std::ifstream(cachePath).good()) {
+        return false; // No cache, the text file is used
+    }
+    
+    auto file = std::make_shared<MappedFile>(cachePath);
+    InstanceCacheHeader header;
+    if (file->size() < sizeof(header)) {
+        std::cerr << "Warning: ignoring truncated cache " << cachePath << std::endl;
+        return false;
+    }
+    std::memcpy(&header, file->begin(), sizeof(header));
+    
+    // The cache must be of this format, for the storage requested and for
+    // the current text file (when there is one)
+    if (std::memcmp(header.magic, INSTANCE_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != INSTANCE_CACHE_VERSION ||
+        header.storage != static_cast<uint32_t>(storage) ||
+        !matchesInstance(header, instanceName, textPath, false)) {
+        return false;
+    }
+    
+    const char* payload = file->begin() + sizeof(header);
+    size_t expected = (storage == DistanceStorage::PACKED)
+        ? PackedDistanceMatrix::packedSize(header.n) * sizeof(float)
+        : static_cast<size_t>(header.n) * DistanceMatrix::paddedStride(header.n) * sizeof(float);
+    if (header.n <= 0 || header.m <= 0 || header.m >= header.n ||
+        header.payloadBytes != expected || file->size() < sizeof(header) + expected ||
+        instanceChecksum(payload, expected) != header.checksum) {
+        std::cerr << "Warning: ignoring corrupted cache " << cachePath << std::endl;
+        return false;
+    }
+    
+    // Use the mapped distances directly, keeping the mapping alive
+    n = header.n;
+    m = header.m;
+    const float* data = reinterpret_cast<const float*>(payload);
+    if (storage == DistanceStorage::PACKED) {
+        packedDistances = PackedDistanceMatrix::view(n, data);
+    } else {
+        distances = DistanceMatrix::view(n, data);
+    }
+    cacheFile = file;
+    loadBytes = file->size();
+    return true;
+}
+
+// Open the tiled cache; the tiles are read later, on demand
+bool ProblemMDD::loadTiledCache(const std::string& cachePath, const std::string& textPath) {
+    std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false; // No cache, it has to be created
+    }
+    uint64_t cacheSize = file.tellg();
+    file.seekg(0);
+    
+    InstanceCacheHeader header;
+    if (cacheSize < sizeof(header) ||
+        !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "Warning: ignoring truncated cache " << cachePath << std::endl;
+        return false;
+    }
+    
+    if (std::memcmp(header.magic, INSTANCE_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != INSTANCE_CACHE_VERSION ||
+        header.storage != static_cast<uint32_t>(DistanceStorage::TILED) ||
+        !matchesInstance(header, instanceName, textPath, false)) {
+        return false;
+    }
+    
+    // The checksum is not verified: it would read the whole matrix
+    if (header.n <= 0 || header.m <= 0 || header.m >= header.n ||
+        header.tileSize != TiledDistanceMatrix::TILE ||
+        header.payloadBytes != TiledDistanceMatrix::payloadSize(header.n) ||
+        cacheSize < sizeof(header) + header.payloadBytes) {
+        std::cerr << "Warning: ignoring corrupted cache " << cachePath << std::endl;
+        return false;
+    }
+    
+    n = header.n;
+    m = header.m;
+    tiledDistances = TiledDistanceMatrix(cachePath, sizeof(header), n,
+                                         TiledDistanceMatrix::DEFAULT_CACHE_BYTES);
+    loadBytes = sizeof(header);
+    return true;
+}
+
+// Write the tiled cache of a text instance, one band of tiles at a time
+void ProblemMDD::convertToTiledCache(const std::string& textPath, const std::string& cachePath) {
+    const int TILE = TiledDistanceMatrix::TILE;
+    MappedFile text(textPath);
+    int n, m;
+    const char* p = parseSizes(text.begin(), text.end(), n, m);
+    
+    InstanceCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, INSTANCE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = INSTANCE_CACHE_VERSION;
+    header.storage = static_cast<uint32_t>(DistanceStorage::TILED);
+    header.n = n;
+    header.m = m;
+    instanceTextStamp(textPath, header.textSize, header.textTime);
+    header.textHash = instanceChecksum(text.begin(), text.size());
+    header.payloadBytes = TiledDistanceMatrix::payloadSize(n);
+    header.tileSize = TILE;
+    std::strncpy(header.name, instanceNameOf(textPath).c_str(), sizeof(header.name) - 1);
+    
+    // Written aside and then renamed over the old cache
+    std::string tmpPath = cachePath + ".tmp";
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error: Could not create cache file " + tmpPath);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    // Rows of the current band (TILE rows, all the columns rounded up to
+    // whole tiles), filled from the text and then written as tiles
+    const int tiles = TiledDistanceMatrix::tilesPerSide(n);
+    const size_t width = static_cast<size_t>(tiles) * TILE;
+    std::vector<float> band(TILE * width, 0.0f);
+    std::vector<float> tile(TILE * TILE);
+    int currentBand = 0;
+    
+    // Write the tiles of the current band on or above the diagonal
+    auto flush = [&]() {
+        for (int tj = currentBand; tj < tiles; tj++) {
+            for (int r = 0; r < TILE; r++) {
+                std::memcpy(&tile[r * TILE], &band[r * width + tj * TILE], TILE * sizeof(float));
+            }
+            file.write(reinterpret_cast<const char*>(tile.data()), tile.size() * sizeof(float));
         }
-        distances[i][j] = dist;
-        distances[j][i] = dist; // Fill the symmetric part
+        std::fill(band.begin(), band.end(), 0.0f);
+        currentBand++;
+    };
+    
+    try {
+        p = skipSpaces(p, text.end());
+        while (p < text.end()) {
+            long i, j;
+            float dist;
+            p = parseInt(p, text.end(), i);
+            if (p) p = parseInt(skipSpaces(p, text.end()), text.end(), j);
+            if (p) p = parseFloat(skipSpaces(p, text.end()), text.end(), dist);
+            if (p == nullptr) {
+                throw std::runtime_error("Error: Malformed line in distance matrix");
+            }
+            p = skipSpaces(p, text.end());
+            
+            if (i < 0 || i >= n || j < 0 || j >= n) {
+                throw std::runtime_error("Error: Invalid indices in distance matrix");
+            }
+            if (i == j) {
+                continue; // The distance of an element to itself is always zero
+            }
+            
+            // The pair is stored in the band of its smaller index
+            long low = std::min(i, j), high = std::max(i, j);
+            if (low / TILE < currentBand) {
+                throw std::runtime_error("Error: Distance lines must be sorted to build a tiled cache");
+            }
+            while (low / TILE > currentBand) {
+                flush();
+            }
+            long first = static_cast<long>(currentBand) * TILE;
+            band[(low - first) * width + high] = dist;
+            if (high / TILE == currentBand) {
+                // Diagonal tiles hold both halves
+                band[(high - first) * width + low] = dist;
+            }
+        }
+        while (currentBand < tiles) {
+            flush();
+        }
+        
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Error: Could not write cache file " + tmpPath);
+        }
+    } catch (...) {
+        // Do not leave a partial cache behind
+        file.close();
+        std::remove(tmpPath.c_str());
+        throw;
     }
+    replaceWithTemporary(tmpPath, cachePath);
+}
 
+// Write the binary cache of the instance
+void ProblemMDD::saveCache(const std::string& cachePath, const std::string& textPath) const {
+    if (storage == DistanceStorage::TILED) {
+        throw std::runtime_error("Error: Tiled instances are cached with convertToTiledCache");
+    }
+    if (storage == DistanceStorage::COORDINATES) {
+        throw std::runtime_error("Error: Instances given by coordinates are not cached");
+    }
+    
+    InstanceCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, INSTANCE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = INSTANCE_CACHE_VERSION;
+    header.storage = static_cast<uint32_t>(storage);
+    header.n = n;
+    header.m = m;
+    uint64_t hashedSize;
+    instanceTextStamp(textPath, header.textSize, header.textTime);
+    instanceTextFingerprint(textPath, hashedSize, header.textHash);
+    std::strncpy(header.name, instanceName.c_str(), sizeof(header.name) - 1);
+    
+    const float* data = (storage == DistanceStorage::PACKED) ? packedDistances.raw() : distances.raw();
+    header.payloadBytes = (storage == DistanceStorage::PACKED)
+        ? PackedDistanceMatrix::packedSize(n) * sizeof(float)
+        : static_cast<size_t>(n) * distances.getStride() * sizeof(float);
+    header.checksum = instanceChecksum(data, header.payloadBytes);
+    
+    // Written aside and then renamed over the old cache, which may be the
+    // mapping that data points to
+    std::string tmpPath = cachePath + ".tmp";
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error: Could not create cache file " + tmpPath);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data), header.payloadBytes);
     file.close();
+    if (!file) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Error: Could not write cache file " + tmpPath);
+    }
+    replaceWithTemporary(tmpPath, cachePath);
+}
+
+// Compare a cache with the whole contents of its text instance
+bool ProblemMDD::verifyCache(const std::string& cachePath, const std::string& textPath) {
+    std::ifstream file(cachePath, std::ios::binary);
+    InstanceCacheHeader header;
+    if (!file.is_open() || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    return std::memcmp(header.magic, INSTANCE_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == INSTANCE_CACHE_VERSION &&
+           std::ifstream(textPath).good() &&
+           matchesInstance(header, instanceNameOf(textPath), textPath, true);
+}
+
+// Parse the lines "i j distance" of a range of the file
+void ProblemMDD::parseDistances(const char* begin, const char* end) {
+    const char* p = skipSpaces(begin, end);
+    while (p < end) {
+        long i, j;
+        float dist;
+        p = parseInt(p, end, i);
+        if (p) p = parseInt(skipSpaces(p, end), end, j);
+        if (p) p = parseFloat(skipSpaces(p, end), end, dist);
+        if (p == nullptr) {
+            throw std::runtime_error("Error: Malformed line in distance matrix");
+        }
+        p = skipSpaces(p, end);
+        
+        if (i < 0 || i >= n || j < 0 || j >= n) {
+            throw std::runtime_error("Error: Invalid indices in distance matrix");
+        }
+        if (i == j) {
+            continue; // The distance of an element to itself is always zero
+        }
+        if (storage == DistanceStorage::PACKED) {
+            packedDistances.set(i, j, dist); // Symmetric by construction
+        } else {
+            distances(i, j) = dist;
+            distances(j, i) = dist; // Fill the symmetric part
+        }
+    }
 }
 
 // Get distance between elements i and j
@@ -57,11 +559,22 @@ float ProblemMDD::getDistance(int i, int j) const {
     if (i < 0 || i >= n || j < 0 || j >= n) {
         throw std::out_of_range("Index out of range in getDistance");
     }
-    return distances[i][j];
+    return distance(i, j);
 }
 
+// Generator that draws from the Random of the calling thread, so that the
+// same code can use it or a generator given by the caller with identical
+// results
+struct GlobalRandomEngine {
+    using result_type = std::mt19937::result_type;
+    static constexpr result_type min() { return std::mt19937::min(); }
+    static constexpr result_type max() { return std::mt19937::max(); }
+    result_type operator()() { return Random::get(); }
+};
+
 // Create a random valid solution with exactly m elements selected
-tSolution ProblemMDD::createSolution() {
+template <class Engine>
+static tSolution randomSolution(int n, int m, Engine& engine) {
     tSolution solution(n, false); // Initialize all to false
     
     // Select m elements randomly
@@ -71,7 +584,7 @@ tSolution ProblemMDD::createSolution() {
     }
     
     // Shuffle and select the first m elements
-    Random::shuffle(indices.begin(), indices.end());
+    std::shuffle(indices.begin(), indices.end(), engine);
     for (int i = 0; i < m; i++) {
         solution[indices[i]] = true;
     }
@@ -79,75 +592,383 @@ tSolution ProblemMDD::createSolution() {
     return solution;
 }
 
+tSolution ProblemMDD::createSolution() {
+    GlobalRandomEngine engine;
+    return randomSolution(n, m, engine);
+}
+
+tSolution ProblemMDD::createSolution(std::mt19937& engine) const {
+    return randomSolution(n, m, engine);
+}
+
+// Create a random subset with exactly m elements selected
+MDDSubset ProblemMDD::createSubset() {
+    MDDSubset subset(n, m);
+    randomizeSubset(subset);
+    return subset;
+}
+
+MDDSubset ProblemMDD::createSubset(std::mt19937& engine) const {
+    MDDSubset subset(n, m);
+    randomizeSubset(subset, engine);
+    return subset;
+}
+
+void ProblemMDD::randomizeSubset(MDDSubset& subset) {
+    GlobalRandomEngine engine;
+    randomizeSubset(subset, engine);
+}
+
+// Only the dense and packed matrices (and points without cached rows) are
+// read without modifying anything
+bool ProblemMDD::isThreadSafe() const {
+    switch (storage) {
+    case DistanceStorage::DENSE:
+    case DistanceStorage::PACKED:
+        return true;
+    case DistanceStorage::COORDINATES:
+        return coordinateDistances.getCacheCapacity() == 0;
+    default:
+        return false;
+    }
+}
+
+// Sum of a dense row over the selected columns, using the SIMD gather kernel
+static float selectionRowSum(const DistanceMatrix& d, int element,
+                             const int* selected, int count) {
+    return simd::gatherSum(d.row(element), selected, count);
+}
+
+// Sum of a row over the selected columns, for the layouts without a gather
+// kernel (packed and coordinates): the values are gathered into a buffer and
+// added in the same order as the dense kernel, so the results are identical
+template <class Matrix>
+static float selectionRowSum(const Matrix& d, int element,
+                             const int* selected, int count) {
+    thread_local std::vector<float> values;
+    values.resize(count);
+    auto row = d.row(element);
+    for (int k = 0; k < count; k++) {
+        values[k] = row[selected[k]];
+    }
+    return simd::sum(values.data(), count);
+}
+
+// Sum of a tiled row over the selected columns, reading them grouped by
+// tile so that every tile of the row is looked up once
+static float selectionRowSum(const TiledDistanceMatrix& d, int element,
+                             const int* selected, int count) {
+    thread_local std::vector<float> values;
+    values.resize(count);
+    d.gatherRow(element, selected, count, values.data());
+    return simd::sum(values.data(), count);
+}
+
+// Differential dispersion of a list of m selected elements
+tFitness ProblemMDD::dispersion(const int* selected) const {
+    // The order of the elements changes the rounding of the sums, so they are
+    // added in increasing order: a selection has a single value, the one the
+    // fitness cache stores, whatever the order it is given in
+    if (!std::is_sorted(selected, selected + m)) {
+        thread_local std::vector<int> sorted;
+        sorted.assign(selected, selected + m);
+        std::sort(sorted.begin(), sorted.end());
+        selected = sorted.data();
+    }
+    
+    uint64_t key = 0;
+    if (fitnessCache) {
+        tFitness value;
+        bool exact;
+        key = selectionHash(selected, m);
+        if (fitnessCache->lookup(key, value, exact) && exact) {
+            return value;
+        }
+    }
+    
+    // Calculate the sum of distances for each selected element (the diagonal
+    // is zero, so the element itself can be included in its own sum)
+    std::vector<float> sumDistances(m);
+    withDistances([&](const auto& d) {
+        for (int k = 0; k < m; k++) {
+            sumDistances[k] = selectionRowSum(d, selected[k], selected, m);
+        }
+    });
+    
+    // Return the differential dispersion (max - min, to be minimized)
+    tFitness value = simd::range(sumDistances.data(), m);
+    if (fitnessCache) {
+        fitnessCache->store(key, value, true);
+    }
+    return value;
+}
+
+// Create the cache of fitness values
+void ProblemMDD::enableFitnessCache(size_t entries) {
+    fitnessCache = std::make_shared<FitnessCache>(entries);
+}
+
+// XOR of the keys of the selected elements
+uint64_t ProblemMDD::selectionHash(const int* selected, int count) const {
+    uint64_t hash = 0;
+    for (int k = 0; k < count; k++) {
+        hash ^= zobristKeys[selected[k]];
+    }
+    return hash;
+}
+
 // Evaluate a solution (calculate differential dispersion)
-tFitness ProblemMDD::fitness(const tSolution& solution) {
-    // Count the number of selected elements
-    int count = 0;
-    for (bool selected : solution) {
-        if (selected) count++;
+tFitness ProblemMDD::fitness(const tSolution& solution) const {
+    // Gather the selected elements once, so only the m x m submatrix is read
+    std::vector<int> selected;
+    selected.reserve(m);
+    for (int i = 0; i < n; i++) {
+        if (solution[i]) selected.push_back(i);
     }
     
     // Check if the solution is valid (has exactly m elements)
-    if (count != m) {
+    if (static_cast<int>(selected.size()) != m) {
         return std::numeric_limits<tFitness>::max(); // Return a very large value for invalid solutions
     }
     
-    // Calculate the sum of distances for each selected element
-    std::vector<float> sumDistances;
-    for (int i = 0; i < n; i++) {
-        if (solution[i]) {
-            float sum = 0.0f;
-            for (int j = 0; j < n; j++) {
-                if (i != j && solution[j]) {
-                    sum += distances[i][j];
+    return dispersion(selected.data());
+}
+
+// Evaluate a subset: its selected elements are already gathered
+tFitness ProblemMDD::fitness(const MDDSubset& subset) const {
+    if (subset.numSelected() != m) {
+        return std::numeric_limits<tFitness>::max(); // Invalid subset
+    }
+    return dispersion(subset.selected());
+}
+
+// Evaluate a batch of solutions, gathering their selected elements first
+void ProblemMDD::fitnessBatch(const tSolution* solutions, size_t count,
+                              tFitness* fitnesses) const {
+    // Only the valid solutions (exactly m elements) go to the kernel
+    std::vector<int> selections;
+    std::vector<size_t> valid;
+    selections.reserve(count * m);
+    for (size_t b = 0; b < count; b++) {
+        size_t before = selections.size();
+        for (int i = 0; i < n; i++) {
+            if (solutions[b][i]) selections.push_back(i);
+        }
+        if (selections.size() - before == static_cast<size_t>(m)) {
+            valid.push_back(b);
+        } else {
+            selections.resize(before);
+            fitnesses[b] = std::numeric_limits<tFitness>::max();
+        }
+    }
+    
+    std::vector<tFitness> values(valid.size());
+    fitnessBatch(selections.data(), valid.size(), values.data());
+    for (size_t k = 0; k < valid.size(); k++) {
+        fitnesses[valid[k]] = values[k];
+    }
+}
+
+// Scratch buffers of the batch evaluation, kept between calls to avoid
+// allocating; one set per thread, so batches can run concurrently
+struct BatchScratch {
+    std::vector<int> sorted;
+    std::vector<int> fill;
+    std::vector<float> sums;
+    std::vector<int> start;
+    std::vector<int> order;
+    std::vector<int> pending;
+    std::vector<size_t> pendingIndex;
+    std::vector<tFitness> pendingFitness;
+};
+
+static BatchScratch& batchScratch() {
+    static thread_local BatchScratch scratch;
+    return scratch;
+}
+
+// Evaluate a batch of selections, skipping those found in the cache
+void ProblemMDD::fitnessBatch(const int* selections, size_t count, tFitness* fitnesses) const {
+    if (!fitnessCache) {
+        dispersionBatch(selections, count, fitnesses);
+        return;
+    }
+    BatchScratch& scratch = batchScratch();
+    
+    // Selections not in the cache are gathered and evaluated together
+    scratch.pending.clear();
+    scratch.pendingIndex.clear();
+    for (size_t b = 0; b < count; b++) {
+        const int* selected = selections + b * m;
+        bool exact;
+        if (!fitnessCache->lookup(selectionHash(selected, m), fitnesses[b], exact) || !exact) {
+            scratch.pending.insert(scratch.pending.end(), selected, selected + m);
+            scratch.pendingIndex.push_back(b);
+        }
+    }
+    
+    scratch.pendingFitness.resize(scratch.pendingIndex.size());
+    dispersionBatch(scratch.pending.data(), scratch.pendingIndex.size(), scratch.pendingFitness.data());
+    for (size_t k = 0; k < scratch.pendingIndex.size(); k++) {
+        const int* selected = scratch.pending.data() + k * m;
+        fitnesses[scratch.pendingIndex[k]] = scratch.pendingFitness[k];
+        fitnessCache->store(selectionHash(selected, m), scratch.pendingFitness[k], true);
+    }
+}
+
+// Evaluate a batch of selections, one block of them at a time
+void ProblemMDD::dispersionBatch(const int* selections, size_t count, tFitness* fitnesses) const {
+    BatchScratch& scratch = batchScratch();
+    // Selections per block: their lists and sums take about 32 KB
+    const size_t BLOCK_BYTES = 32 * 1024;
+    const size_t block = std::max<size_t>(1, BLOCK_BYTES / (m * (sizeof(int) + sizeof(float))));
+    
+    for (size_t first = 0; first < count; first += block) {
+        const size_t size = std::min(block, count - first);
+        const size_t entries = size * m;
+        
+        // Every selection in increasing order, as in dispersion
+        scratch.sorted.assign(selections + first * m, selections + first * m + entries);
+        for (size_t b = 0; b < size; b++) {
+            std::sort(scratch.sorted.begin() + b * m, scratch.sorted.begin() + (b + 1) * m);
+        }
+        const int* selected = scratch.sorted.data();
+        
+        // Entries (selection, slot) of the block sorted by element, so that
+        // each row is loaded once (counting sort)
+        scratch.start.assign(n + 1, 0);
+        for (size_t e = 0; e < entries; e++) {
+            scratch.start[selected[e] + 1]++;
+        }
+        for (int i = 0; i < n; i++) {
+            scratch.start[i + 1] += scratch.start[i];
+        }
+        scratch.order.resize(entries);
+        scratch.fill.assign(scratch.start.begin(), scratch.start.end() - 1);
+        for (size_t e = 0; e < entries; e++) {
+            scratch.order[scratch.fill[selected[e]]++] = e;
+        }
+        
+        // Sums of every selected element, visiting the rows in order
+        scratch.sums.resize(entries);
+        withDistances([&](const auto& d) {
+            for (int i = 0; i < n; i++) {
+                for (int p = scratch.start[i]; p < scratch.start[i + 1]; p++) {
+                    size_t e = scratch.order[p];
+                    scratch.sums[e] = selectionRowSum(d, i, selected + (e / m) * m, m);
                 }
             }
-            sumDistances.push_back(sum);
+        });
+        
+        for (size_t b = 0; b < size; b++) {
+            fitnesses[first + b] = simd::range(scratch.sums.data() + b * m, m);
         }
     }
+}
+
+// Free list of infos of each thread (bounded), freed when the thread ends
+struct SolutionInfoPool {
+    static const size_t MAX_SIZE = 64;
+    std::vector<MDDSolutionInfo*> free;
     
-    // Find the maximum and minimum sum
-    float maxSum = *std::max_element(sumDistances.begin(), sumDistances.end());
-    float minSum = *std::min_element(sumDistances.begin(), sumDistances.end());
-    
-    // Return the differential dispersion (to be minimized)
-    return maxSum - minSum;
+    ~SolutionInfoPool() {
+        for (MDDSolutionInfo* info : free) {
+            delete info;
+        }
+    }
+};
+
+static SolutionInfoPool& solutionInfoPool() {
+    static thread_local SolutionInfoPool pool;
+    return pool;
+}
+
+// Take an info from the pool of the thread, or a new one if it is empty
+static MDDSolutionInfoHandle acquireSolutionInfo() {
+    SolutionInfoPool& pool = solutionInfoPool();
+    if (pool.free.empty()) {
+        return MDDSolutionInfoHandle(new MDDSolutionInfo());
+    }
+    MDDSolutionInfo* info = pool.free.back();
+    pool.free.pop_back();
+    return MDDSolutionInfoHandle(info);
+}
+
+// Return an info to the pool of the thread (or free it if the pool is full)
+void MDDSolutionInfoRecycler::operator()(MDDSolutionInfo* info) const {
+    SolutionInfoPool& pool = solutionInfoPool();
+    if (pool.free.size() < SolutionInfoPool::MAX_SIZE) {
+        pool.free.push_back(info);
+    } else {
+        delete info;
+    }
 }
 
 // Generate factoring information for a solution
-SolutionFactoringInfo* ProblemMDD::generateFactoringInfo(const tSolution& solution) {
+SolutionFactoringInfo* ProblemMDD::generateFactoringInfo(const tSolution& solution) const {
+    return generateFactoringInfo(MDDSubset(solution));
+}
+
+// Generate factoring information for a subset
+MDDSolutionInfo* ProblemMDD::generateFactoringInfo(const MDDSubset& subset) const {
     MDDSolutionInfo* info = new MDDSolutionInfo();
+    fillFactoringInfo(*info, subset);
+    return info;
+}
+
+// Generate factoring information for a subset into a pooled info
+MDDSolutionInfoHandle ProblemMDD::makeFactoringInfo(const MDDSubset& subset) const {
+    MDDSolutionInfoHandle info = acquireSolutionInfo();
+    fillFactoringInfo(*info, subset);
+    return info;
+}
+
+// Fill factoring information, reusing the vectors of the info
+void ProblemMDD::fillFactoringInfo(MDDSolutionInfo& info, const MDDSubset& subset) const {
+    // Reserving n elements once, the vectors are never reallocated when the
+    // info is recycled, whatever the size of the selection
+    info.selected.reserve(n);
+    info.nonSelected.reserve(n);
+    info.sumDistances.reserve(n);
     
-    // Store selected and non-selected elements
+    // Copy selected and non-selected elements, and the slot of each one
+    info.selected.assign(subset.selected(), subset.selected() + subset.numSelected());
+    info.nonSelected.assign(subset.nonSelected(), subset.nonSelected() + subset.numNonSelected());
+    info.slot.resize(n);
     for (int i = 0; i < n; i++) {
-        if (solution[i]) {
-            info->selected.push_back(i);
-        } else {
-            info->nonSelected.push_back(i);
-        }
+        info.slot[i] = subset.slot(i);
     }
     
     // Calculate sum of distances for each selected element
-    info->sumDistances.resize(info->selected.size());
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        int elemI = info->selected[i];
-        float sum = 0.0f;
-        for (size_t j = 0; j < info->selected.size(); j++) {
-            if (i != j) {
-                int elemJ = info->selected[j];
-                sum += distances[elemI][elemJ];
+    info.sumDistances.resize(info.selected.size());
+    withDistances([&](const auto& d) {
+        for (size_t i = 0; i < info.selected.size(); i++) {
+            auto rowI = d.row(info.selected[i]);
+            float sum = 0.0f;
+            for (size_t j = 0; j < info.selected.size(); j++) {
+                if (i != j) {
+                    sum += rowI[info.selected[j]];
+                }
             }
+            info.sumDistances[i] = sum;
         }
-        info->sumDistances[i] = sum;
-    }
-    
-    return info;
+        
+        // Sum of distances of every element to the selected ones
+        info.sumToSelected.assign(n, 0.0f);
+        for (int s : info.selected) {
+            auto rowS = d.row(s);
+            for (int e = 0; e < n; e++) {
+                info.sumToSelected[e] += rowS[e];
+            }
+        }
+    });
+    info.updateExtremes();
 }
 
 // Factorized fitness calculation for local search
 tFitness ProblemMDD::fitness(const tSolution& solution,
                            SolutionFactoringInfo* solution_info,
-                           unsigned pos_change, tDomain new_value) {
+                           unsigned pos_change, tDomain new_value) const {
     // We're implementing the Int(Sel,i,j) move: 
     // Swap a selected element (pos_change) with a non-selected one (new_value is index in nonSelected)
     
@@ -159,100 +980,141 @@ tFitness ProblemMDD::fitness(const tSolution& solution,
         return fitness(newSol);
     }
     
-    // Find indices in selected and nonSelected arrays
-    int selectedIdx = -1;
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        if (info->selected[i] == pos_change) {
-            selectedIdx = i;
-            break;
-        }
-    }
+    // Find the slot of the element in the selected array (O(1))
+    int selectedIdx = info->selectedSlot(pos_change);
     
     if (selectedIdx == -1 || new_value >= info->nonSelected.size()) {
         // Invalid move, return worst possible fitness
         return std::numeric_limits<tFitness>::max();
     }
     
-    int nonSelectedElem = info->nonSelected[new_value];
+    return evaluateSwap(*info, selectedIdx, new_value);
+}
+
+// Build the quantized copy of the distances
+void ProblemMDD::enableQuantization() {
+    withDistances([&](const auto& d) {
+        float maxAbs = 0.0f;
+        for (int i = 0; i < n; i++) {
+            auto rowI = d.row(i);
+            for (int j = 0; j < n; j++) {
+                maxAbs = std::max(maxAbs, std::abs(rowI[j]));
+            }
+        }
+        quantizedDistances = QuantizedDistanceMatrix(n, maxAbs);
+        for (int i = 0; i < n; i++) {
+            auto rowI = d.row(i);
+            for (int j = 0; j < n; j++) {
+                quantizedDistances.set(i, j, rowI[j]);
+            }
+        }
+    });
+}
+
+// Lower bound of the swap evaluation from the quantized distances
+tFitness ProblemMDD::swapLowerBound(const MDDSolutionInfo& info, size_t selectedIdx,
+                                    size_t nonSelectedIdx, tFitness cutoff) const {
+    const int* selected = info.selected.data();
+    const float* sums = info.sumDistances.data();
+    const size_t count = info.selected.size();
+    const int removed = selected[selectedIdx];
+    const int added = info.nonSelected[nonSelectedIdx];
+    const int16_t* rowOut = quantizedDistances.row(removed);
+    const int16_t* rowIn = quantizedDistances.row(added);
+    const float scale = quantizedDistances.getScale();
     
-    // Create a copy of the sum distances
-    std::vector<float> newSumDistances = info->sumDistances;
+    // Each new sum changes by two distances (error <= scale), so the
+    // dispersion is off by at most 2 * scale, plus the rounding of the
+    // float sums (a few ulps of the largest sum)
+    float magnitude = std::max(std::abs(sums[info.maxSlot]), std::abs(sums[info.minSlot])) +
+                      2 * 32767 * scale;
+    float slack = 2 * scale + 8 * std::numeric_limits<float>::epsilon() * magnitude;
     
-    // Remove contribution of the element to be removed
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        if (i != selectedIdx) {
-            newSumDistances[i] -= distances[info->selected[i]][pos_change];
-        }
-    }
+    const float newSum = info.sumToSelected[added] - rowIn[removed] * scale;
+    float maxSum = newSum;
+    float minSum = newSum;
     
-    // Add contribution of the new element
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        if (i != selectedIdx) {
-            newSumDistances[i] += distances[info->selected[i]][nonSelectedElem];
-        }
-    }
+    // The difference of the two rows is taken in integers, so each slot
+    // needs a single conversion and multiplication
+    auto update = [&](size_t i) {
+        float value = sums[i] + scale * (rowIn[selected[i]] - rowOut[selected[i]]);
+        maxSum = std::max(maxSum, value);
+        minSum = std::min(minSum, value);
+    };
     
-    // Calculate new sum for the swapped element
-    float newSum = 0.0f;
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        if (i != selectedIdx) {
-            newSum += distances[nonSelectedElem][info->selected[i]];
+    // Same order as evaluateSwap: current extremes first, then the rest
+    if (info.maxSlot != selectedIdx) update(info.maxSlot);
+    if (info.minSlot != selectedIdx) update(info.minSlot);
+    if (maxSum - minSum - slack >= cutoff) {
+        return maxSum - minSum - slack;
+    }
+    auto accumulate = [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; i++) {
+            update(i);
+            if (maxSum - minSum - slack >= cutoff) {
+                return false;
+            }
         }
+        return true;
+    };
+    if (accumulate(0, selectedIdx)) {
+        accumulate(selectedIdx + 1, count);
     }
     
-    // Replace the old sum with the new one
-    newSumDistances[selectedIdx] = newSum;
-    
-    // Find max and min in the new sums
-    float maxSum = *std::max_element(newSumDistances.begin(), newSumDistances.end());
-    float minSum = *std::min_element(newSumDistances.begin(), newSumDistances.end());
-    
-    // Return the differential dispersion
-    return maxSum - minSum;
+    return maxSum - minSum - slack;
 }
 
 // Update factoring information after a move
 void ProblemMDD::updateSolutionFactoringInfo(SolutionFactoringInfo* solution_info,
                                             const tSolution& solution,
-                                            unsigned pos_change, tDomain new_value) {
+                                            unsigned pos_change, tDomain new_value) const {
     MDDSolutionInfo* info = dynamic_cast<MDDSolutionInfo*>(solution_info);
     if (!info) return;
     
-    // Find indices in selected and nonSelected arrays
-    int selectedIdx = -1;
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        if (info->selected[i] == pos_change) {
-            selectedIdx = i;
-            break;
-        }
-    }
+    // Find the slot of the element in the selected array (O(1))
+    int selectedIdx = info->selectedSlot(pos_change);
     
     if (selectedIdx == -1 || new_value >= info->nonSelected.size()) {
         return; // Invalid move
     }
     
-    int nonSelectedElem = info->nonSelected[new_value];
+    applySwap(*info, selectedIdx, new_value);
+}
+
+// Apply the swap of two slots to the factoring information
+void ProblemMDD::applySwap(MDDSolutionInfo& info, size_t selectedIdx,
+                           size_t nonSelectedIdx) const {
+    int selectedElem = info.selected[selectedIdx];
+    int nonSelectedElem = info.nonSelected[nonSelectedIdx];
     
-    // Update sums for all other selected elements
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        if (i != selectedIdx) {
-            // Remove contribution of removed element
-            info->sumDistances[i] -= distances[info->selected[i]][pos_change];
-            // Add contribution of new element
-            info->sumDistances[i] += distances[info->selected[i]][nonSelectedElem];
+    withDistances([&](const auto& d) {
+        // Rows of the removed and added elements (the matrix is symmetric)
+        auto rowOut = d.row(selectedElem);
+        auto rowIn = d.row(nonSelectedElem);
+        
+        // Update sums for all other selected elements
+        for (size_t i = 0; i < info.selected.size(); i++) {
+            if (i != selectedIdx) {
+                // Remove contribution of removed element
+                info.sumDistances[i] -= rowOut[info.selected[i]];
+                // Add contribution of new element
+                info.sumDistances[i] += rowIn[info.selected[i]];
+            }
         }
-    }
-    
-    // Calculate new sum for the swapped element
-    float newSum = 0.0f;
-    for (size_t i = 0; i < info->selected.size(); i++) {
-        if (i != selectedIdx) {
-            newSum += distances[nonSelectedElem][info->selected[i]];
+        
+        // New sum for the swapped element, from its cached sum
+        info.sumDistances[selectedIdx] = info.sumToSelected[nonSelectedElem] - rowIn[selectedElem];
+        
+        // Update the sums of every element to the selection (O(n))
+        for (int e = 0; e < n; e++) {
+            info.sumToSelected[e] += rowIn[e] - rowOut[e];
         }
-    }
+    });
     
-    // Update the selected and nonSelected lists and the sum for the swapped element
-    info->sumDistances[selectedIdx] = newSum;
-    info->selected[selectedIdx] = nonSelectedElem;
-    info->nonSelected[new_value] = pos_change;
-} 
\ No newline at end of file
+    // Update the selected and nonSelected lists
+    info.selected[selectedIdx] = nonSelectedElem;
+    info.nonSelected[nonSelectedIdx] = selectedElem;
+    info.slot[nonSelectedElem] = selectedIdx;
+    info.slot[selectedElem] = nonSelectedIdx;
+    info.updateExtremes();
+}
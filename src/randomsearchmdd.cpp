@@ -1,7 +1,23 @@
 #include <randomsearchmdd.h>
+#include <problemmdd.h>
+#include <parallel.h>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <iomanip>
+#include <vector>
+
+// Scratch buffers of a thread, reused by all the batches it runs
+struct SampleScratch {
+    MDDSubset subset;
+    std::vector<int> selections;
+    std::vector<tFitness> fitnesses;
+};
+
+static SampleScratch& sampleScratch() {
+    static thread_local SampleScratch scratch;
+    return scratch;
+}
 
 /**
  * Generate 100,000 random solutions and return the best one.
@@ -14,35 +30,87 @@ ResultMH RandomSearchMDD::optimize(Problem* problem, int maxevals) {
     // Always use 100,000 evaluations as per the problem specification
     const int NUM_EVALUATIONS = 100000;
     
+    // Check that it is a MDD problem
+    ProblemMDD* mddProblem = dynamic_cast<ProblemMDD*>(problem);
+    assert(mddProblem != nullptr);
+    
     // Initialize timers and counters
     Timer timer;
     timer.start();
     
-    // Variables to store the best solution
-    tSolution best_solution;
-    tFitness best_fitness = std::numeric_limits<tFitness>::max(); // Initialize to worst possible
+    const int n = mddProblem->getN();
+    const int m = mddProblem->getM();
+    
+    // Base seed, from which the stream of each batch is derived
+    const uint64_t seed = Random::get<uint64_t>();
+    
+    // The samples are evaluated in batches: their selected elements are
+    // copied one after another and evaluated with a single call
+    const int BATCH = 250;
+    const int numBatches = (NUM_EVALUATIONS + BATCH - 1) / BATCH;
+    
+    // Best sample of each batch (the first one on ties), in its own slot
+    std::vector<tFitness> batchFitness(numBatches);
+    std::vector<int> batchSelection(static_cast<size_t>(numBatches) * m);
     
-    // Generate and evaluate 100,000 random solutions
-    for (int i = 0; i < NUM_EVALUATIONS; i++) {
-        // Create a random solution
-        tSolution solution = problem->createSolution();
+    parallel::parallelFor(numBatches, threads, [&](size_t batch) {
+        // The subset starts from the initial partition in every batch, so
+        // its samples do not depend on the batches run before by the thread
+        SampleScratch& scratch = sampleScratch();
+        if (scratch.subset.size() != n || scratch.subset.numSelected() != m) {
+            scratch.subset = MDDSubset(n, m);
+        } else {
+            scratch.subset.reset();
+        }
+        scratch.selections.resize(static_cast<size_t>(BATCH) * m);
+        scratch.fitnesses.resize(BATCH);
         
-        // Evaluate it
-        tFitness fitness = problem->fitness(solution);
+        // Select new random subsets from the stream of the batch
+        parallel::CounterEngine engine(parallel::streamSeed(seed, batch));
+        int first = static_cast<int>(batch) * BATCH;
+        int size = std::min(BATCH, NUM_EVALUATIONS - first);
+        for (int b = 0; b < size; b++) {
+            mddProblem->randomizeSubset(scratch.subset, engine);
+            std::copy(scratch.subset.selected(), scratch.subset.selected() + m,
+                      scratch.selections.begin() + b * m);
+        }
         
-        // Update best if this solution is better
-        if (fitness < best_fitness) {
-            best_solution = solution;
-            best_fitness = fitness;
+        // Evaluate them and keep the best one
+        mddProblem->fitnessBatch(scratch.selections.data(), size, scratch.fitnesses.data());
+        int best = 0;
+        for (int b = 1; b < size; b++) {
+            if (scratch.fitnesses[b] < scratch.fitnesses[best]) {
+                best = b;
+            }
+        }
+        batchFitness[batch] = scratch.fitnesses[best];
+        std::copy(scratch.selections.begin() + best * m, scratch.selections.begin() + (best + 1) * m,
+                  batchSelection.begin() + batch * m);
+    });
+    
+    // Deterministic reduction, in the order of the samples: the best batch
+    // (the first one on ties) holds the best sample
+    int bestBatch = 0;
+    for (int batch = 0; batch < numBatches; batch++) {
+        if (batchFitness[batch] < batchFitness[bestBatch]) {
+            bestBatch = batch;
         }
         
         // Optional: Print progress every 10,000 evaluations
-        if ((i + 1) % 10000 == 0) {
-            std::cout << "RandomSearchMDD: " << (i + 1) << " evaluations completed. "
-                      << "Best fitness so far: " << best_fitness << std::endl;
+        int evaluated = std::min(NUM_EVALUATIONS, (batch + 1) * BATCH);
+        if (evaluated % 10000 == 0) {
+            std::cout << "RandomSearchMDD: " << evaluated << " evaluations completed. "
+                      << "Best fitness so far: " << batchFitness[bestBatch] << std::endl;
         }
     }
     
+    // Convert the best selection into a solution
+    tSolution best_solution(n, false);
+    for (int k = 0; k < m; k++) {
+        best_solution[batchSelection[static_cast<size_t>(bestBatch) * m + k]] = true;
+    }
+    tFitness best_fitness = batchFitness[bestBatch];
+    
     // Stop the timer
     timer.stop();
     
@@ -53,4 +121,4 @@ ResultMH RandomSearchMDD::optimize(Problem* problem, int maxevals) {
     
     // Return the result
     return ResultMH(best_solution, best_fitness, NUM_EVALUATIONS);
-} 
\ No newline at end of file
+}
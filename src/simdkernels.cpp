@@ -0,0 +1,239 @@
+#include <simdkernels.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace simd {
+
+// Scalar versions, used as fallback and for the tails of the vector loops
+
+static float gatherSumScalar(const float* row, const int* indices, int count) {
+    float sum = 0.0f;
+    for (int k = 0; k < count; k++) {
+        sum += row[indices[k]];
+    }
+    return sum;
+}
+
+static float sumScalar(const float* values, int count) {
+    float sum = 0.0f;
+    for (int k = 0; k < count; k++) {
+        sum += values[k];
+    }
+    return sum;
+}
+
+static float rangeScalar(const float* values, int count) {
+    float maxValue = values[0];
+    float minValue = values[0];
+    for (int k = 1; k < count; k++) {
+        if (values[k] > maxValue) maxValue = values[k];
+        if (values[k] < minValue) minValue = values[k];
+    }
+    return maxValue - minValue;
+}
+
+static float squaredDistanceScalar(const float* a, const float* b, int count) {
+    float sum = 0.0f;
+    for (int k = 0; k < count; k++) {
+        float diff = a[k] - b[k];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+#ifdef SIMD_X86
+
+// SSE versions: there is no gather instruction, so four lanes are loaded
+// separately and added with a single vector add
+
+__attribute__((target("sse2")))
+static float horizontalSum(__m128 v) {
+    __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    sums = _mm_add_ss(sums, shuffled);
+    return _mm_cvtss_f32(sums);
+}
+
+__attribute__((target("sse2")))
+static float gatherSumSSE(const float* row, const int* indices, int count) {
+    __m128 acc = _mm_setzero_ps();
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 values = _mm_set_ps(row[indices[k + 3]], row[indices[k + 2]],
+                                   row[indices[k + 1]], row[indices[k]]);
+        acc = _mm_add_ps(acc, values);
+    }
+    return horizontalSum(acc) + gatherSumScalar(row, indices + k, count - k);
+}
+
+__attribute__((target("sse2")))
+static float sumSSE(const float* values, int count) {
+    __m128 acc = _mm_setzero_ps();
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        acc = _mm_add_ps(acc, _mm_loadu_ps(values + k));
+    }
+    return horizontalSum(acc) + sumScalar(values + k, count - k);
+}
+
+__attribute__((target("sse2")))
+static float rangeSSE(const float* values, int count) {
+    if (count < 4) {
+        return rangeScalar(values, count);
+    }
+    __m128 maxValues = _mm_loadu_ps(values);
+    __m128 minValues = maxValues;
+    int k = 4;
+    for (; k + 4 <= count; k += 4) {
+        __m128 v = _mm_loadu_ps(values + k);
+        maxValues = _mm_max_ps(maxValues, v);
+        minValues = _mm_min_ps(minValues, v);
+    }
+    float maxLanes[4], minLanes[4];
+    _mm_storeu_ps(maxLanes, maxValues);
+    _mm_storeu_ps(minLanes, minValues);
+    float maxValue = maxLanes[0], minValue = minLanes[0];
+    for (int l = 1; l < 4; l++) {
+        if (maxLanes[l] > maxValue) maxValue = maxLanes[l];
+        if (minLanes[l] < minValue) minValue = minLanes[l];
+    }
+    for (; k < count; k++) {
+        if (values[k] > maxValue) maxValue = values[k];
+        if (values[k] < minValue) minValue = values[k];
+    }
+    return maxValue - minValue;
+}
+
+__attribute__((target("sse2")))
+static float squaredDistanceSSE(const float* a, const float* b, int count) {
+    __m128 acc = _mm_setzero_ps();
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + k), _mm_loadu_ps(b + k));
+        acc = _mm_add_ps(acc, _mm_mul_ps(diff, diff));
+    }
+    return horizontalSum(acc) + squaredDistanceScalar(a + k, b + k, count - k);
+}
+
+// AVX2 versions: eight lanes per gather instruction
+
+__attribute__((target("avx2")))
+static float gatherSumAVX2(const float* row, const int* indices, int count) {
+    __m256 acc = _mm256_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256i columns = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + k));
+        acc = _mm256_add_ps(acc, _mm256_i32gather_ps(row, columns, sizeof(float)));
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    return horizontalSum(half) + gatherSumSSE(row, indices + k, count - k);
+}
+
+__attribute__((target("avx2")))
+static float sumAVX2(const float* values, int count) {
+    __m256 acc = _mm256_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(values + k));
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    return horizontalSum(half) + sumSSE(values + k, count - k);
+}
+
+__attribute__((target("avx2")))
+static float rangeAVX2(const float* values, int count) {
+    if (count < 8) {
+        return rangeSSE(values, count);
+    }
+    __m256 maxValues = _mm256_loadu_ps(values);
+    __m256 minValues = maxValues;
+    int k = 8;
+    for (; k + 8 <= count; k += 8) {
+        __m256 v = _mm256_loadu_ps(values + k);
+        maxValues = _mm256_max_ps(maxValues, v);
+        minValues = _mm256_min_ps(minValues, v);
+    }
+    // Remaining values are covered by a last (overlapping) full vector
+    if (k < count) {
+        __m256 v = _mm256_loadu_ps(values + count - 8);
+        maxValues = _mm256_max_ps(maxValues, v);
+        minValues = _mm256_min_ps(minValues, v);
+    }
+    float maxLanes[8], minLanes[8];
+    _mm256_storeu_ps(maxLanes, maxValues);
+    _mm256_storeu_ps(minLanes, minValues);
+    float maxValue = maxLanes[0], minValue = minLanes[0];
+    for (int l = 1; l < 8; l++) {
+        if (maxLanes[l] > maxValue) maxValue = maxLanes[l];
+        if (minLanes[l] < minValue) minValue = minLanes[l];
+    }
+    return maxValue - minValue;
+}
+
+__attribute__((target("avx2")))
+static float squaredDistanceAVX2(const float* a, const float* b, int count) {
+    __m256 acc = _mm256_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k));
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(diff, diff));
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    return horizontalSum(half) + squaredDistanceSSE(a + k, b + k, count - k);
+}
+
+#endif
+
+/**
+ * Set of kernels selected for the current CPU.
+ */
+struct Kernels {
+    float (*gatherSum)(const float*, const int*, int);
+    float (*sum)(const float*, int);
+    float (*range)(const float*, int);
+    float (*squaredDistance)(const float*, const float*, int);
+    const char* name;
+};
+
+// Choose the best kernels supported by the CPU (only once)
+static const Kernels& kernels() {
+    static const Kernels selected = []() {
+#ifdef SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Kernels{gatherSumAVX2, sumAVX2, rangeAVX2, squaredDistanceAVX2, "avx2"};
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return Kernels{gatherSumSSE, sumSSE, rangeSSE, squaredDistanceSSE, "sse"};
+        }
+#endif
+        return Kernels{gatherSumScalar, sumScalar, rangeScalar, squaredDistanceScalar, "scalar"};
+    }();
+    return selected;
+}
+
+float gatherSum(const float* row, const int* indices, int count) {
+    return kernels().gatherSum(row, indices, count);
+}
+
+float sum(const float* values, int count) {
+    return kernels().sum(values, count);
+}
+
+float range(const float* values, int count) {
+    return kernels().range(values, count);
+}
+
+float squaredDistance(const float* a, const float* b, int count) {
+    return kernels().squaredDistance(a, b, count);
+}
+
+const char* kernelName() {
+    return kernels().name;
+}
+
+} // namespace simd
@@ -0,0 +1,139 @@
+#include <simulatedannealingmdd.h>
+#include <problemmdd.h>
+#include <timer.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+// Constructor
+SimulatedAnnealingMDD::SimulatedAnnealingMDD(CoolingSchedule schedule, double alpha,
+                                             double finalRatio)
+    : MHTrayectory(), schedule(schedule), alpha(alpha), finalRatio(finalRatio),
+      acceptanceRate(0.0) {
+    if (alpha <= 0.0 || alpha >= 1.0) {
+        throw std::runtime_error("Error: the cooling factor must be in (0, 1)");
+    }
+    if (finalRatio <= 0.0 || finalRatio >= 1.0) {
+        throw std::runtime_error("Error: the final temperature ratio must be in (0, 1)");
+    }
+}
+
+/**
+ * Run Simulated Annealing from a given solution.
+ * 
+ * @param problem The MDD problem to solve
+ * @param current The initial solution
+ * @param fitness The fitness of the initial solution
+ * @param maxevals Maximum number of evaluations
+ * @return A ResultMH containing the best solution found, its fitness, and the number of evaluations
+ */
+ResultMH SimulatedAnnealingMDD::optimize(Problem* problem, const tSolution& current,
+                                         tFitness fitness, int maxevals) {
+    // Comprobamos que es un problema MDD
+    ProblemMDD* mddProblem = dynamic_cast<ProblemMDD*>(problem);
+    assert(mddProblem != nullptr);
+    
+    Timer timer;
+    timer.start();
+    
+    const int n = mddProblem->getN();
+    const int m = mddProblem->getM();
+    const int numNonSelected = n - m;
+    
+    // Vecinos y éxitos por temperatura
+    const int maxNeighbors = 10 * n;
+    const int maxSuccesses = n;
+    
+    // Temperaturas inicial (T0 = mu·f0 / -ln(phi), mu = phi = 0.3) y final
+    const double MU = 0.3, PHI = 0.3;
+    double temperature = std::max(MU * fitness / -std::log(PHI), 1e-6);
+    double endTemperature = finalRatio * temperature;
+    
+    // Evaluaciones de los vecinos: una se reserva para el fitness exacto de
+    // la mejor solución al final
+    const int budget = maxevals - 1;
+    
+    // Lundy-Mees: la temperatura baja tras cada evaluación (1/T crece
+    // linealmente), con beta para llegar a la final al agotar el presupuesto
+    const double beta = (temperature - endTemperature) /
+                        (std::max(1, budget) * temperature * endTemperature);
+    
+    // Solución actual, con su información de factorización, y la mejor
+    tSolution currentSolution = current;
+    double currentFitness = fitness;
+    ProblemMDD::InfoHandle info = mddProblem->makeFactoringInfo(MDDSubset(currentSolution));
+    tSolution bestSolution = currentSolution;
+    double bestFitness = currentFitness;
+    int evaluations = 0;
+    
+    acceptanceRates.clear();
+    long accepted = 0;
+    bool progress = numNonSelected > 0;
+    
+    while (progress && evaluations < budget && temperature > endTemperature) {
+        int neighbors = 0;
+        int successes = 0;
+        
+        while (neighbors < maxNeighbors && successes < maxSuccesses && evaluations < budget) {
+            // Intercambio aleatorio
+            int selectedIdx = Random::get<int>(0, m - 1);
+            int nonSelectedIdx = Random::get<int>(0, numNonSelected - 1);
+            
+            // Regla de Metropolis: se acepta si f' < f - T·ln(u), así que ese
+            // valor sirve de corte a la evaluación factorizada (u en (0, 1])
+            double u = 1.0 - Random::get<double>(0.0, 1.0);
+            double threshold = currentFitness - temperature * std::log(u);
+            double newFitness = mddProblem->evaluateSwap(*info, selectedIdx, nonSelectedIdx, threshold);
+            evaluations++;
+            neighbors++;
+            
+            if (newFitness < threshold) {
+                currentSolution[info->selected[selectedIdx]] = false;
+                currentSolution[info->nonSelected[nonSelectedIdx]] = true;
+                mddProblem->applySwap(*info, selectedIdx, nonSelectedIdx);
+                currentFitness = newFitness;
+                successes++;
+                
+                if (currentFitness < bestFitness) {
+                    bestSolution = currentSolution;
+                    bestFitness = currentFitness;
+                }
+            }
+            
+            if (schedule == CoolingSchedule::LUNDY_MEES) {
+                temperature = temperature / (1 + beta * temperature);
+            }
+        }
+        
+        accepted += successes;
+        acceptanceRates.push_back(neighbors > 0 ? static_cast<double>(successes) / neighbors : 0.0);
+        // Congelada si no se acepta nada; con Lundy-Mees la temperatura sigue
+        // el presupuesto, así que se agota aunque haya tramos sin éxitos
+        progress = successes > 0 || schedule == CoolingSchedule::LUNDY_MEES;
+        
+        // Enfriamiento geométrico, tras cada temperatura
+        if (schedule == CoolingSchedule::GEOMETRIC) {
+            temperature *= alpha;
+        }
+    }
+    acceptanceRate = evaluations > 0 ? static_cast<double>(accepted) / evaluations : 0.0;
+    
+    // Fitness exacto de la mejor solución (sin el redondeo acumulado de las
+    // sumas actualizadas en cada intercambio)
+    bestFitness = mddProblem->fitness(bestSolution);
+    evaluations++;
+    
+    timer.stop();
+    std::cout << "\n" << getName() << " completado en " << std::fixed << std::setprecision(2)
+              << timer.elapsed() << " segundos (" << acceptanceRates.size() << " temperaturas, "
+              << evaluations / std::max(timer.elapsed(), 1e-9) / 1e6 << " M evaluaciones/s)." << std::endl;
+    std::cout << "Tasa de aceptación: " << 100 * acceptanceRate << "% (primera temperatura: "
+              << 100 * (acceptanceRates.empty() ? 0.0 : acceptanceRates.front()) << "%, última: "
+              << 100 * (acceptanceRates.empty() ? 0.0 : acceptanceRates.back()) << "%)" << std::endl;
+    std::cout << "Fitness final: " << bestFitness << std::endl;
+    
+    return ResultMH(bestSolution, bestFitness, evaluations);
+}
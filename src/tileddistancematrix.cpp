@@ -0,0 +1,147 @@
+#include <tileddistancematrix.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+// Value of lastIndex when no tile is remembered
+static const size_t NO_TILE = std::numeric_limits<size_t>::max();
+
+// Constructor: empty matrix
+TiledDistanceMatrix::TiledDistanceMatrix()
+    : n(0), tiles(0), offset(0), capacity(0), head(-1), tail(-1), used(0),
+      lastIndex(NO_TILE), lastSlot(-1), hits(0), misses(0), epoch(0) {}
+
+// Constructor: open the file of tiles
+TiledDistanceMatrix::TiledDistanceMatrix(const std::string& path, size_t offset,
+                                         int n, size_t cacheBytes)
+    : TiledDistanceMatrix() {
+    this->n = n;
+    this->tiles = tilesPerSide(n);
+    this->path = path;
+    this->offset = offset;
+    file.reset(new std::ifstream(path, std::ios::binary));
+    if (!file->is_open()) {
+        throw std::runtime_error("Error: Could not open tiled matrix " + path);
+    }
+    setCacheSize(cacheBytes);
+}
+
+// Resize (and empty) the cache of tiles
+void TiledDistanceMatrix::setCacheSize(size_t cacheBytes) {
+    const size_t tileBytes = static_cast<size_t>(TILE) * TILE * sizeof(float);
+    size_t total = static_cast<size_t>(tiles) * (tiles + 1) / 2;
+    capacity = std::max<size_t>(1, std::min(total, cacheBytes / tileBytes));
+
+    pool.assign(static_cast<size_t>(capacity) * TILE * TILE, 0.0f);
+    slotOf.clear();
+    tileOf.assign(capacity, 0);
+    prev.assign(capacity, -1);
+    next.assign(capacity, -1);
+    head = tail = -1;
+    used = 0;
+    lastIndex = NO_TILE;
+    epoch++;
+}
+
+// Move a slot to the head of the LRU list
+void TiledDistanceMatrix::touch(int slot) const {
+    if (head == slot) return;
+    // Unlink it (if it is in the list)
+    if (prev[slot] != -1) next[prev[slot]] = next[slot];
+    if (next[slot] != -1) prev[next[slot]] = prev[slot];
+    if (tail == slot) tail = prev[slot];
+    // Link it at the head
+    prev[slot] = -1;
+    next[slot] = head;
+    if (head != -1) prev[head] = slot;
+    head = slot;
+    if (tail == -1) tail = slot;
+}
+
+// Return tile (ti, tj), reading it (and evicting the least recently used
+// one if the cache is full) when it is not cached
+const float* TiledDistanceMatrix::tile(int ti, int tj) const {
+    const size_t tileFloats = static_cast<size_t>(TILE) * TILE;
+    size_t index = tileIndex(ti, tj, tiles);
+    if (index == lastIndex) {
+        hits++;
+        return pool.data() + lastSlot * tileFloats;
+    }
+
+    int slot;
+    auto found = slotOf.find(index);
+    if (found != slotOf.end()) {
+        hits++;
+        slot = found->second;
+    } else {
+        misses++;
+        if (used < capacity) {
+            slot = used++;
+        } else {
+            // Evict the least recently used tile
+            slot = tail;
+            slotOf.erase(tileOf[slot]);
+            epoch++;
+        }
+
+        file->clear();
+        file->seekg(offset + index * tileFloats * sizeof(float));
+        file->read(reinterpret_cast<char*>(pool.data() + slot * tileFloats),
+                   tileFloats * sizeof(float));
+        if (!*file) {
+            throw std::runtime_error("Error: Could not read tile from " + path);
+        }
+        slotOf[index] = slot;
+        tileOf[slot] = index;
+    }
+
+    touch(slot);
+    lastIndex = index;
+    lastSlot = slot;
+    return pool.data() + slot * tileFloats;
+}
+
+// Scratch buffers of gatherRow, kept between calls to avoid allocating;
+// one set per thread
+struct GatherScratch {
+    std::vector<int> start;
+    std::vector<int> order;
+    std::vector<int> fill;
+};
+
+static GatherScratch& gatherScratch() {
+    static thread_local GatherScratch scratch;
+    return scratch;
+}
+
+// Read several columns of a row, visiting them grouped by tile column
+void TiledDistanceMatrix::gatherRow(int i, const int* columns, int count, float* out) const {
+    GatherScratch& scratch = gatherScratch();
+    std::vector<int>& start = scratch.start;
+    std::vector<int>& order = scratch.order;
+    std::vector<int>& fill = scratch.fill;
+
+    // Counting sort of the positions by tile column
+    start.assign(tiles + 1, 0);
+    for (int k = 0; k < count; k++) {
+        start[columns[k] / TILE + 1]++;
+    }
+    for (int c = 0; c < tiles; c++) {
+        start[c + 1] += start[c];
+    }
+    order.resize(count);
+    fill.assign(start.begin(), start.end() - 1);
+    for (int k = 0; k < count; k++) {
+        order[fill[columns[k] / TILE]++] = k;
+    }
+
+    // Each tile is looked up once for all its columns
+    for (int c = 0; c < tiles; c++) {
+        if (start[c] == start[c + 1]) continue;
+        const float* data = rowTile(i, c);
+        for (int p = start[c]; p < start[c + 1]; p++) {
+            int k = order[p];
+            out[k] = fromTile(data, i, columns[k]);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include <problemmdd.h>
+#include <simulatedannealingmdd.h>
+#include <timer.h>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <random.hpp>
+
+// Main function for testing Simulated Annealing
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed> <evaluations>" << std::endl;
+        return 1;
+    }
+    
+    try {
+        // Get command line arguments
+        std::string instance_path = argv[1];
+        long seed = std::stol(argv[2]);
+        int maxevals = std::stoi(argv[3]);
+        
+        // Load the problem instance
+        std::cout << "Loading problem instance from: " << instance_path << std::endl;
+        ProblemMDD problem(instance_path);
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+        
+        // Run both cooling schedules from the same initial solution
+        const CoolingSchedule schedules[] = {CoolingSchedule::GEOMETRIC, CoolingSchedule::LUNDY_MEES};
+        for (CoolingSchedule schedule : schedules) {
+            Random::seed(seed);
+            SimulatedAnnealingMDD annealing(schedule);
+            std::cout << "\nRunning " << annealing.getName() << "..." << std::endl;
+            
+            Timer timer;
+            timer.start();
+            ResultMH result = annealing.optimize(&problem, maxevals);
+            timer.stop();
+            
+            std::cout << "Execution time: " << timer.elapsed() << " seconds" << std::endl;
+            std::cout << "Evaluations per second: " << result.evaluations / timer.elapsed() << std::endl;
+            std::cout << "Total evaluations: " << result.evaluations << std::endl;
+            std::cout << "Best fitness: " << result.fitness << std::endl;
+            
+            // Acceptance rate of a few temperatures along the schedule
+            const std::vector<double>& rates = annealing.getAcceptanceRates();
+            std::cout << "Acceptance rates:";
+            for (size_t t = 0; t < rates.size(); t += std::max<size_t>(1, rates.size() / 8)) {
+                std::cout << " " << 100 * rates[t] << "%";
+            }
+            std::cout << std::endl;
+            
+            // The result must be a solution with m elements, its exact
+            // fitness, and within the budget
+            int selected = 0;
+            for (bool s : result.solution) selected += s;
+            if (selected == problem.getM() && result.evaluations <= static_cast<unsigned>(maxevals) &&
+                problem.fitness(result.solution) == result.fitness) {
+                std::cout << annealing.getName() << " result is correct!" << std::endl;
+            } else {
+                std::cout << "ERROR: " << annealing.getName()
+                          << " result is not a valid solution with its fitness!" << std::endl;
+            }
+        }
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,136 @@
+#include <problemmdd.h>
+#include <instancecache.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Checks that two problems have the same distances
+static bool sameDistances(const ProblemMDD& a, const ProblemMDD& b) {
+    if (a.getN() != b.getN() || a.getM() != b.getM()) {
+        return false;
+    }
+    for (int i = 0; i < a.getN(); i++) {
+        for (int j = 0; j < a.getN(); j++) {
+            if (a.getDistance(i, j) != b.getDistance(i, j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Reports a check, returning whether it passed
+static bool check(bool passed, const std::string& what) {
+    std::cout << (passed ? "" : "ERROR: ") << what << (passed ? " is correct!" : " failed!") << std::endl;
+    return passed;
+}
+
+// Main function for testing the binary caches: they must give the distances
+// of the text, can be rewritten while they are in use, and must be rejected
+// once the text changes (even keeping its size) or when they belong to
+// another instance
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file>" << std::endl;
+        return 1;
+    }
+
+    std::string textPath = "test_cache_instance.txt";
+    std::string otherPath = "test_cache_other.txt";
+    auto cleanup = [&]() {
+        for (const std::string& path : {textPath, otherPath}) {
+            std::remove(path.c_str());
+            std::remove(instanceCachePath(path).c_str());
+            std::remove(tiledCachePath(path).c_str());
+            std::remove((instanceCachePath(path) + ".tmp").c_str());
+            std::remove((tiledCachePath(path) + ".tmp").c_str());
+        }
+    };
+
+    try {
+        // Work on a copy of the instance, which is edited later
+        std::ifstream input(argv[1], std::ios::binary);
+        if (!input.is_open()) {
+            throw std::runtime_error("Error: Could not open file " + std::string(argv[1]));
+        }
+        std::stringstream contents;
+        contents << input.rdbuf();
+        std::string text = contents.str();
+        cleanup();
+        std::ofstream(textPath, std::ios::binary) << text;
+
+        bool correct = true;
+        ProblemMDD parsed(textPath);
+
+        // Round trip of the dense, packed and tiled caches
+        ProblemMDD packedParsed(textPath, DistanceStorage::PACKED);
+        parsed.saveCache(instanceCachePath(textPath), textPath);
+        ProblemMDD dense(textPath);
+        correct &= check(dense.isCached() && sameDistances(dense, parsed) &&
+                         ProblemMDD::verifyCache(instanceCachePath(textPath), textPath), "Dense cache");
+
+        // Converting again writes the cache from the mapping of the old one
+        dense.saveCache(instanceCachePath(textPath), textPath);
+        ProblemMDD rewritten(textPath);
+        correct &= check(rewritten.isCached() && sameDistances(rewritten, parsed) &&
+                         sameDistances(dense, parsed), "Rewrite of a mapped cache");
+
+        packedParsed.saveCache(instanceCachePath(textPath), textPath);
+        ProblemMDD packed(textPath, DistanceStorage::PACKED);
+        correct &= check(packed.isCached() && sameDistances(packed, parsed), "Packed cache");
+
+        ProblemMDD tiledFirst(textPath, DistanceStorage::TILED);
+        ProblemMDD tiled(textPath, DistanceStorage::TILED);
+        correct &= check(!tiledFirst.isCached() && tiled.isCached() && sameDistances(tiled, parsed),
+                         "Tiled cache");
+        ProblemMDD::convertToTiledCache(textPath, tiledCachePath(textPath));
+        correct &= check(sameDistances(tiled, parsed), "Rewrite of an open tiled cache");
+
+        // A cache copied next to another instance belongs to the old one
+        parsed.saveCache(instanceCachePath(textPath), textPath);
+        std::ofstream(otherPath, std::ios::binary) << text;
+        {
+            std::ifstream cache(instanceCachePath(textPath), std::ios::binary);
+            std::ofstream(instanceCachePath(otherPath), std::ios::binary) << cache.rdbuf();
+        }
+        ProblemMDD other(otherPath);
+        correct &= check(!other.isCached(), "Rejection of another instance's cache");
+
+        // Change one digit of the first distance, keeping the size of the text
+        size_t line = text.find('\n') + 1;
+        size_t digit = text.find_first_of("0123456789", text.find_last_of(" \t", text.find('\n', line)) + 1);
+        if (line == 0 || digit == std::string::npos) {
+            throw std::runtime_error("Error: The instance has no distances");
+        }
+        text[digit] = (text[digit] == '9') ? '1' : text[digit] + 1;
+        auto savedTime = std::filesystem::last_write_time(textPath);
+        std::ofstream(textPath, std::ios::binary) << text;
+        // The clock of the file system may be coarser than this test
+        std::filesystem::last_write_time(textPath, savedTime + std::chrono::seconds(1));
+
+        ProblemMDD edited(textPath);
+        ProblemMDD editedTiled(textPath, DistanceStorage::TILED);
+        correct &= check(!edited.isCached() && !sameDistances(edited, parsed),
+                         "Rejection of a stale dense cache");
+        correct &= check(!editedTiled.isCached() && sameDistances(editedTiled, edited),
+                         "Rejection of a stale tiled cache");
+
+        // Loads do not read the text, so an edit that keeps its size and
+        // time is only found by comparing the contents
+        std::filesystem::last_write_time(textPath, savedTime);
+        correct &= check(!ProblemMDD::verifyCache(instanceCachePath(textPath), textPath) &&
+                         ProblemMDD::verifyCache(tiledCachePath(textPath), textPath),
+                         "Verification of the contents of the text");
+
+        cleanup();
+        return correct ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        cleanup();
+        return 1;
+    }
+}
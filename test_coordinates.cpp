@@ -0,0 +1,115 @@
+#include <problemmdd.h>
+#include <timer.h>
+#include <random.hpp>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Main function for testing the distances computed from coordinates: a
+// random instance is written both as points and as a distance matrix, and
+// both problems must give the same distances
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        std::cout << "Usage: " << argv[0] << " <n> <m> <dimensions> <seed>" << std::endl;
+        return 1;
+    }
+
+    int n = std::stoi(argv[1]);
+    int m = std::stoi(argv[2]);
+    int dimensions = std::stoi(argv[3]);
+    Random::seed(std::stol(argv[4]));
+
+    std::string pointsPath = "test_coordinates_points.txt";
+    std::string matrixPath = "test_coordinates_matrix.txt";
+
+    try {
+        // Random points in [0, 10]^d
+        std::ofstream points(pointsPath);
+        points << n << " " << m << " " << dimensions << "\n";
+        points << std::setprecision(9);
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < dimensions; k++) {
+                points << (k > 0 ? " " : "") << Random::get<float>(0.0f, 10.0f);
+            }
+            points << "\n";
+        }
+        points.close();
+
+        Timer timer;
+        timer.start();
+        ProblemMDD problem(pointsPath, DistanceStorage::COORDINATES);
+        timer.stop();
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM()
+                  << ", d = " << dimensions << " (" << simd::kernelName() << ")" << std::endl;
+        std::cout << "Load time: " << timer.elapsed() * 1000 << " ms" << std::endl;
+
+        // The same distances, written as the text format (exact round trip)
+        std::ofstream matrix(matrixPath);
+        matrix << n << " " << m << "\n" << std::setprecision(9);
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                matrix << i << " " << j << " " << problem.getDistance(i, j) << "\n";
+            }
+        }
+        matrix.close();
+        ProblemMDD dense(matrixPath);
+
+        bool correct = true;
+        for (int i = 0; i < n && correct; i++) {
+            for (int j = 0; j < n; j++) {
+                if (problem.getDistance(i, j) != dense.getDistance(i, j)) {
+                    correct = false;
+                    break;
+                }
+            }
+        }
+
+        // Local search moves must give the same fitness (up to the order of
+        // the sums) with both problems
+        MDDSubset subset = problem.createSubset();
+        MDDSolutionInfo* info = problem.generateFactoringInfo(subset);
+        MDDSolutionInfo* denseInfo = dense.generateFactoringInfo(subset);
+        double maxError = 0.0;
+        timer.reset();
+        timer.start();
+        for (int move = 0; move < 1000; move++) {
+            size_t selectedIdx = Random::get<size_t>(0, m - 1);
+            size_t nonSelectedIdx = Random::get<size_t>(0, n - m - 1);
+            tFitness value = problem.evaluateSwap(*info, selectedIdx, nonSelectedIdx);
+            tFitness expected = dense.evaluateSwap(*denseInfo, selectedIdx, nonSelectedIdx);
+            maxError = std::max<double>(maxError, std::abs(value - expected) / std::max(1.0f, expected));
+            if (move % 10 == 0) {
+                problem.applySwap(*info, selectedIdx, nonSelectedIdx);
+                dense.applySwap(*denseInfo, selectedIdx, nonSelectedIdx);
+            }
+        }
+        timer.stop();
+        if (maxError > 1e-4) {
+            correct = false;
+        }
+
+        std::cout << "Moves time: " << timer.elapsed() * 1000 << " ms" << std::endl;
+        std::cout << "Max relative error: " << maxError << std::endl;
+        std::cout << "Row hits: " << problem.getRowHits()
+                  << ", misses: " << problem.getRowMisses() << std::endl;
+        if (correct) {
+            std::cout << "Coordinates are correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: Coordinates give different distances!" << std::endl;
+        }
+
+        delete info;
+        delete denseInfo;
+        std::remove(pointsPath.c_str());
+        std::remove(matrixPath.c_str());
+        return correct ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::remove(pointsPath.c_str());
+        std::remove(matrixPath.c_str());
+        return 1;
+    }
+}
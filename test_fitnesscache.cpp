@@ -0,0 +1,72 @@
+#include <problemmdd.h>
+#include <randomsearchmdd.h>
+#include <greedymdd.h>
+#include <ilsmdd.h>
+#include <localsearchmdd.h>
+#include <simulatedannealingmdd.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <random.hpp>
+
+// Main function for testing the fitness cache: every algorithm must give
+// the same result with the cache and without it
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed>" << std::endl;
+        return 1;
+    }
+
+    try {
+        // Get command line arguments
+        std::string instance_path = argv[1];
+        long seed = std::stol(argv[2]);
+
+        std::cout << "Loading problem instance from: " << instance_path << std::endl;
+        ProblemMDD problem(instance_path);
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+
+        std::vector<std::pair<std::string, std::unique_ptr<MH>>> algorithms;
+        algorithms.emplace_back("RandomSearch", new RandomSearchMDD(1));
+        algorithms.emplace_back("RandomSearch (4 threads)", new RandomSearchMDD(4));
+        algorithms.emplace_back("Greedy", new GreedyMDD());
+        algorithms.emplace_back("randLS", new LocalSearchMDD(ExplorationStrategy::RANDOM, false));
+        algorithms.emplace_back("heurLS", new LocalSearchMDD(ExplorationStrategy::HEURISTIC, false));
+        algorithms.emplace_back("bestLS", new LocalSearchMDD(ExplorationStrategy::BEST, false));
+        algorithms.emplace_back("ILS", new IteratedLocalSearchMDD());
+        algorithms.emplace_back("SA-geometric", new SimulatedAnnealingMDD(CoolingSchedule::GEOMETRIC));
+        algorithms.emplace_back("SA-LundyMees", new SimulatedAnnealingMDD(CoolingSchedule::LUNDY_MEES));
+
+        bool correct = true;
+        for (auto& algorithm : algorithms) {
+            problem.disableFitnessCache();
+            Random::seed(seed);
+            ResultMH uncached = algorithm.second->optimize(&problem, 100000);
+
+            problem.enableFitnessCache(1 << 16);
+            Random::seed(seed);
+            ResultMH cached = algorithm.second->optimize(&problem, 100000);
+
+            bool same = cached.fitness == uncached.fitness &&
+                        cached.evaluations == uncached.evaluations &&
+                        cached.solution == uncached.solution;
+            std::cout << algorithm.first << ": " << uncached.fitness << " without the cache, "
+                      << cached.fitness << " with it (" << problem.getFitnessCache()->getHits()
+                      << " hits)" << std::endl;
+            if (!same) {
+                std::cout << "ERROR: " << algorithm.first << " changes with the fitness cache!" << std::endl;
+            }
+            correct &= same;
+        }
+
+        if (correct) {
+            std::cout << "Fitness cache is correct!" << std::endl;
+        }
+        return correct ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
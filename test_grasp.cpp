@@ -0,0 +1,101 @@
+#include <problemmdd.h>
+#include <graspmdd.h>
+#include <timer.h>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <random.hpp>
+
+// Helper function to print a solution
+void printSolution(const tSolution& solution, const std::string& title) {
+    std::cout << title << ": [";
+    bool first = true;
+    for (size_t i = 0; i < solution.size(); i++) {
+        if (solution[i]) {
+            if (!first) std::cout << ", ";
+            std::cout << i;
+            first = false;
+        }
+    }
+    std::cout << "]" << std::endl;
+}
+
+// Main function for testing GRASP
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed> <alpha> <threads>" << std::endl;
+        return 1;
+    }
+    
+    try {
+        // Get command line arguments
+        std::string instance_path = argv[1];
+        long seed = std::stol(argv[2]);
+        double alpha = std::stod(argv[3]);
+        unsigned threads = std::stoul(argv[4]);
+        
+        // Load the problem instance (without fitness cache, so that the
+        // evaluations of an iteration do not depend on the others)
+        std::cout << "Loading problem instance from: " << instance_path << std::endl;
+        ProblemMDD problem(instance_path);
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+        
+        // Run with the given number of threads
+        Random::seed(seed);
+        GraspMDD grasp(alpha, 16, ExplorationStrategy::HEURISTIC, threads);
+        Timer timer;
+        timer.start();
+        ResultMH result = grasp.optimize(&problem, 100000);
+        timer.stop();
+        
+        std::cout << "\nResults with " << threads << " threads:" << std::endl;
+        std::cout << "Execution time: " << timer.elapsed() << " seconds" << std::endl;
+        std::cout << "Total evaluations: " << result.evaluations << std::endl;
+        std::cout << "Best fitness: " << result.fitness << std::endl;
+        printSolution(result.solution, "Best solution");
+        
+        // The same seed with a single thread must give the same result
+        Random::seed(seed);
+        GraspMDD serialGrasp(alpha, 16, ExplorationStrategy::HEURISTIC, 1);
+        ResultMH serial = serialGrasp.optimize(&problem, 100000);
+        
+        if (serial.solution == result.solution && serial.fitness == result.fitness &&
+            serial.evaluations == result.evaluations) {
+            std::cout << "GRASP is reproducible!" << std::endl;
+        } else {
+            std::cout << "ERROR: GRASP depends on the number of threads!" << std::endl;
+        }
+        
+        // The result must be the fitness of its solution (up to the rounding
+        // of the incremental evaluation of the local search), with m elements
+        int selected = 0;
+        for (bool s : result.solution) selected += s;
+        if (selected == problem.getM() &&
+            std::abs(problem.fitness(result.solution) - result.fitness) < 1e-2) {
+            std::cout << "GRASP result is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: GRASP result is not a valid solution with its fitness!" << std::endl;
+        }
+        
+        // The constructions count against the budget, which is never
+        // exceeded, even when it only allows some of the iterations
+        const int n = problem.getN(), m = problem.getM();
+        const int constructionEvals = (m - 1) * n - m * (m - 1) / 2;
+        const int smallBudget = 3 * (constructionEvals + 1) + 10;
+        Random::seed(seed);
+        GraspMDD smallGrasp(alpha, 16, ExplorationStrategy::HEURISTIC, threads);
+        ResultMH small = smallGrasp.optimize(&problem, smallBudget);
+        if (result.evaluations <= 100000 && small.evaluations <= static_cast<unsigned>(smallBudget) &&
+            small.evaluations > static_cast<unsigned>(3 * constructionEvals)) {
+            std::cout << "GRASP budget is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: GRASP exceeds its budget (" << small.evaluations
+                      << " of " << smallBudget << ")!" << std::endl;
+        }
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,85 @@
+#include <problemmdd.h>
+#include <ilsmdd.h>
+#include <localsearchmdd.h>
+#include <timer.h>
+#include <iostream>
+#include <string>
+#include <random.hpp>
+
+// Helper function to print a solution
+void printSolution(const tSolution& solution, const std::string& title) {
+    std::cout << title << ": [";
+    bool first = true;
+    for (size_t i = 0; i < solution.size(); i++) {
+        if (solution[i]) {
+            if (!first) std::cout << ", ";
+            std::cout << i;
+            first = false;
+        }
+    }
+    std::cout << "]" << std::endl;
+}
+
+// Main function for testing Iterated Local Search
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed> <perturbation_size>" << std::endl;
+        std::cout << "  perturbation_size: swaps of each perturbation (0 for m/10)" << std::endl;
+        return 1;
+    }
+    
+    try {
+        // Get command line arguments
+        std::string instance_path = argv[1];
+        long seed = std::stol(argv[2]);
+        int perturbationSize = std::stoi(argv[3]);
+        
+        // Load the problem instance
+        std::cout << "Loading problem instance from: " << instance_path << std::endl;
+        ProblemMDD problem(instance_path);
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+        
+        // Run ILS
+        Random::seed(seed);
+        IteratedLocalSearchMDD ils(perturbationSize);
+        Timer timer;
+        timer.start();
+        ResultMH result = ils.optimize(&problem, 100000);
+        timer.stop();
+        
+        std::cout << "\nResults:" << std::endl;
+        std::cout << "Execution time: " << timer.elapsed() << " seconds" << std::endl;
+        std::cout << "Total evaluations: " << result.evaluations << std::endl;
+        std::cout << "Best fitness: " << result.fitness << std::endl;
+        printSolution(result.solution, "Best solution");
+        
+        // The result must be a solution with m elements and its exact
+        // fitness, within the budget
+        int selected = 0;
+        for (bool s : result.solution) selected += s;
+        if (selected == problem.getM() && result.evaluations <= 100000 &&
+            problem.fitness(result.solution) == result.fitness) {
+            std::cout << "ILS result is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: ILS result is not a valid solution with its fitness!" << std::endl;
+        }
+        
+        // Its first descent is the local search from the same random
+        // solution, so it cannot be worse than its optimum (evaluated in full)
+        Random::seed(seed);
+        LocalSearchMDD localSearch(ExplorationStrategy::HEURISTIC, false);
+        ResultMH descent = localSearch.optimize(&problem, 100000);
+        tFitness descentFitness = problem.fitness(descent.solution);
+        std::cout << "Local search fitness: " << descentFitness << std::endl;
+        if (result.fitness <= descentFitness) {
+            std::cout << "ILS improves the local search!" << std::endl;
+        } else {
+            std::cout << "ERROR: ILS is worse than a single local search!" << std::endl;
+        }
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
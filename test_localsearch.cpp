@@ -24,7 +24,7 @@ void printSolution(const tSolution& solution, const std::string& title) {
 int main(int argc, char* argv[]) {
     if (argc < 4) {
         std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed> <strategy>" << std::endl;
-        std::cout << "  strategy: 0 for randLS (random), 1 for heurLS (heuristic)" << std::endl;
+        std::cout << "  strategy: 0 for randLS (random), 1 for heurLS (heuristic), 2 for bestLS (best improvement)" << std::endl;
         return 1;
     }
     
@@ -35,15 +35,16 @@ int main(int argc, char* argv[]) {
         int strategyInt = std::stoi(argv[3]);
         
         // Validate strategy
-        if (strategyInt < 0 || strategyInt > 1) {
-            std::cerr << "Error: strategy must be 0 (random) or 1 (heuristic)" << std::endl;
+        if (strategyInt < 0 || strategyInt > 2) {
+            std::cerr << "Error: strategy must be 0 (random), 1 (heuristic) or 2 (best)" << std::endl;
             return 1;
         }
         
         // Convert to enum
-        ExplorationStrategy strategy = (strategyInt == 0) ? 
-                                      ExplorationStrategy::RANDOM : 
-                                      ExplorationStrategy::HEURISTIC;
+        const ExplorationStrategy strategies[] = {
+            ExplorationStrategy::RANDOM, ExplorationStrategy::HEURISTIC, ExplorationStrategy::BEST
+        };
+        ExplorationStrategy strategy = strategies[strategyInt];
         
         // Initialize random number generator with the seed
         Random::seed(seed);
@@ -56,11 +57,9 @@ int main(int argc, char* argv[]) {
         std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
         
         // Create and run the LocalSearch algorithm
-        std::cout << "\nRunning LocalSearch algorithm with " 
-                  << (strategy == ExplorationStrategy::RANDOM ? "random" : "heuristic") 
-                  << " exploration..." << std::endl;
-        
         LocalSearchMDD localSearch(strategy);
+        std::cout << "\nRunning LocalSearch algorithm " << localSearch.getName() 
+                  << "..." << std::endl;
         
         // Start timer
         Timer timer;
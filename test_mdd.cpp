@@ -1,7 +1,11 @@
 #include <problemmdd.h>
 #include <timer.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <random>
+#include <thread>
 #include <vector>
 
 // Helper function to print a solution
@@ -31,17 +35,20 @@ void printVector(const std::vector<float>& v, const std::string& title) {
 // Main function for testing
 int main(int argc, char* argv[]) {
     if (argc < 2) {
-        std::cout << "Usage: " << argv[0] << " <path_to_instance_file>" << std::endl;
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> [load_threads]" << std::endl;
         return 1;
     }
     
     try {
         // Load the problem instance
         std::cout << "Loading problem instance from: " << argv[1] << std::endl;
-        ProblemMDD problem(argv[1]);
+        int loadThreads = (argc > 2) ? std::stoi(argv[2]) : 1;
+        ProblemMDD problem(argv[1], DistanceStorage::DENSE, loadThreads);
         
         std::cout << "Instance: " << problem.getInstanceName() << std::endl;
         std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+        std::cout << "Load time: " << problem.getLoadTime() * 1000 << " ms ("
+                  << problem.getLoadThroughput() << " MB/s, " << loadThreads << " threads)" << std::endl;
         
         // Create a random solution
         std::cout << "\nCreating a random solution..." << std::endl;
@@ -106,8 +113,9 @@ int main(int argc, char* argv[]) {
                 std::cout << "Verification fitness: " << verifyFitness << std::endl;
                 std::cout << "Regular evaluation time: " << timer.elapsed() * 1000 << " ms" << std::endl;
                 
-                // Check if factorization is correct
-                if (std::abs(newFitness - verifyFitness) < 1e-6) {
+                // Check if factorization is correct (the sums are added in
+                // another order, so up to the float rounding)
+                if (std::abs(newFitness - verifyFitness) <= 1e-5 * std::max(1.0f, std::abs(verifyFitness))) {
                     std::cout << "Factorization is correct!" << std::endl;
                 } else {
                     std::cout << "ERROR: Factorization gives different result!" << std::endl;
@@ -115,9 +123,118 @@ int main(int argc, char* argv[]) {
             }
         }
         
+        // Test the packed (upper triangular) storage
+        std::cout << "\nTesting packed storage..." << std::endl;
+        ProblemMDD packedProblem(argv[1], DistanceStorage::PACKED);
+
+        timer.reset();
+        timer.start();
+        tFitness packedFitness = packedProblem.fitness(solution);
+        timer.stop();
+
+        std::cout << "Packed fitness: " << packedFitness << std::endl;
+        std::cout << "Packed evaluation time: " << timer.elapsed() * 1000 << " ms" << std::endl;
+
+        if (packedFitness == fitness) {
+            std::cout << "Packed storage is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: Packed storage gives different result!" << std::endl;
+        }
+
+        // Test the tiled (out-of-core) storage, with room for a single tile
+        // so that most lookups have to evict one
+        std::cout << "\nTesting tiled storage..." << std::endl;
+        ProblemMDD tiledProblem(argv[1], DistanceStorage::TILED);
+        tiledProblem.setTileCacheSize(0);
+
+        timer.reset();
+        timer.start();
+        tFitness tiledFitness = tiledProblem.fitness(solution);
+        timer.stop();
+
+        std::cout << "Tiled fitness: " << tiledFitness << std::endl;
+        std::cout << "Tiled evaluation time: " << timer.elapsed() * 1000 << " ms" << std::endl;
+        std::cout << "Tile hits: " << tiledProblem.getTileHits()
+                  << ", misses: " << tiledProblem.getTileMisses() << std::endl;
+
+        bool tiledCorrect = (tiledFitness == fitness);
+        for (int i = 0; i < problem.getN() && tiledCorrect; i++) {
+            for (int j = 0; j < problem.getN(); j++) {
+                if (tiledProblem.getDistance(i, j) != problem.getDistance(i, j)) {
+                    tiledCorrect = false;
+                    break;
+                }
+            }
+        }
+        if (tiledCorrect) {
+            std::cout << "Tiled storage is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: Tiled storage gives different result!" << std::endl;
+        }
+
+        // Test concurrent evaluation: several threads share the problem,
+        // each one drawing solutions from its own generator
+        std::cout << "\nTesting concurrent evaluation..." << std::endl;
+        const int THREADS = 4, SAMPLES = 200;
+        std::vector<std::vector<tSolution>> samples(THREADS);
+        std::vector<std::vector<tFitness>> concurrent(THREADS);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < THREADS; t++) {
+            workers.emplace_back([&, t]() {
+                std::mt19937 engine(t);
+                for (int s = 0; s < SAMPLES; s++) {
+                    samples[t].push_back(problem.createSolution(engine));
+                    concurrent[t].push_back(problem.fitness(samples[t].back()));
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        bool concurrentCorrect = problem.isThreadSafe();
+        for (int t = 0; t < THREADS; t++) {
+            std::mt19937 engine(t);
+            for (int s = 0; s < SAMPLES; s++) {
+                if (problem.createSolution(engine) != samples[t][s] ||
+                    problem.fitness(samples[t][s]) != concurrent[t][s]) {
+                    concurrentCorrect = false;
+                }
+            }
+        }
+        if (concurrentCorrect) {
+            std::cout << "Concurrent evaluation is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: Concurrent evaluation gives different results!" << std::endl;
+        }
+
+        // Test the pooled factoring info: a handle released and requested
+        // again reuses the same object, refilled with the new selection
+        std::cout << "\nTesting pooled factoring info..." << std::endl;
+        const MDDSolutionInfo* pooledAddress = nullptr;
+        {
+            ProblemMDD::InfoHandle pooled = problem.makeFactoringInfo(MDDSubset(solution));
+            pooledAddress = pooled.get();
+        }
+        tSolution other = problem.createSolution();
+        ProblemMDD::InfoHandle pooled = problem.makeFactoringInfo(MDDSubset(other));
+        MDDSolutionInfo* reference = problem.generateFactoringInfo(MDDSubset(other));
+
+        bool pooledCorrect = (pooled.get() == pooledAddress) &&
+                             pooled->selected == reference->selected &&
+                             pooled->nonSelected == reference->nonSelected &&
+                             pooled->sumDistances == reference->sumDistances &&
+                             pooled->sumToSelected == reference->sumToSelected;
+        delete reference;
+        if (pooledCorrect) {
+            std::cout << "Pooled factoring info is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: Pooled factoring info differs from a new one!" << std::endl;
+        }
+
         // Cleanup
         delete info;
-        
+
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,99 @@
+#include <problemmdd.h>
+#include <localsearchmdd.h>
+#include <multistart.h>
+#include <timer.h>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <random.hpp>
+
+// Helper function to print a solution
+void printSolution(const tSolution& solution, const std::string& title) {
+    std::cout << title << ": [";
+    bool first = true;
+    for (size_t i = 0; i < solution.size(); i++) {
+        if (solution[i]) {
+            if (!first) std::cout << ", ";
+            std::cout << i;
+            first = false;
+        }
+    }
+    std::cout << "]" << std::endl;
+}
+
+// Main function for testing the parallel multi-start driver
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        std::cout << "Usage: " << argv[0] << " <path_to_instance_file> <seed> <starts> <threads>" << std::endl;
+        return 1;
+    }
+    
+    try {
+        // Get command line arguments
+        std::string instance_path = argv[1];
+        long seed = std::stol(argv[2]);
+        int starts = std::stoi(argv[3]);
+        unsigned threads = std::stoul(argv[4]);
+        
+        // Load the problem instance (without fitness cache, so that the
+        // evaluations of a start do not depend on the others)
+        std::cout << "Loading problem instance from: " << instance_path << std::endl;
+        ProblemMDD problem(instance_path);
+        std::cout << "n = " << problem.getN() << ", m = " << problem.getM() << std::endl;
+        
+        MultiStart::Factory factory = []() {
+            return std::unique_ptr<MH>(new LocalSearchMDD(ExplorationStrategy::HEURISTIC));
+        };
+        
+        // Run with the given number of threads, silencing the starts
+        Random::seed(seed);
+        MultiStart parallelRun(factory, starts, threads);
+        Timer timer;
+        timer.start();
+        std::cout.setstate(std::ios::failbit);
+        ResultMH result = parallelRun.optimize(&problem, 100000);
+        std::cout.clear();
+        timer.stop();
+        
+        std::cout << "\nResults with " << threads << " threads:" << std::endl;
+        std::cout << "Execution time: " << timer.elapsed() << " seconds" << std::endl;
+        std::cout << "Total evaluations: " << result.evaluations << std::endl;
+        std::cout << "Best fitness: " << result.fitness << std::endl;
+        printSolution(result.solution, "Best solution");
+        
+        // The same seed with a single thread must give the same result
+        Random::seed(seed);
+        MultiStart serialRun(factory, starts, 1);
+        timer.reset();
+        timer.start();
+        std::cout.setstate(std::ios::failbit);
+        ResultMH serial = serialRun.optimize(&problem, 100000);
+        std::cout.clear();
+        timer.stop();
+        
+        std::cout << "\nResults with 1 thread:" << std::endl;
+        std::cout << "Execution time: " << timer.elapsed() << " seconds" << std::endl;
+        std::cout << "Best fitness: " << serial.fitness << std::endl;
+        
+        if (serial.solution == result.solution && serial.fitness == result.fitness &&
+            serial.evaluations == result.evaluations) {
+            std::cout << "Multi-start is reproducible!" << std::endl;
+        } else {
+            std::cout << "ERROR: Multi-start depends on the number of threads!" << std::endl;
+        }
+        
+        // The result must be the fitness of its solution (up to the rounding
+        // of the incremental evaluation of the local search)
+        if (std::abs(problem.fitness(result.solution) - result.fitness) < 1e-2) {
+            std::cout << "Multi-start result is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: Multi-start fitness does not match its solution!" << std::endl;
+        }
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
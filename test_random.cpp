@@ -63,6 +63,25 @@ int main(int argc, char* argv[]) {
         std::cout << "Best fitness: " << result.fitness << std::endl;
         printSolution(result.solution, "Best solution");
         
+        // The parallel mode, with the same seed, must give the same result
+        std::cout << "\nRunning Random Search algorithm on 4 threads..." << std::endl;
+        Random::seed(seed);
+        RandomSearchMDD parallel_search(4);
+        timer.reset();
+        timer.start();
+        std::cout.setstate(std::ios::failbit);
+        ResultMH parallel_result = parallel_search.optimize(&problem, 100000);
+        std::cout.clear();
+        timer.stop();
+        std::cout << "Execution time: " << timer.elapsed() << " seconds" << std::endl;
+        
+        if (parallel_result.solution == result.solution && parallel_result.fitness == result.fitness &&
+            parallel_result.evaluations == result.evaluations) {
+            std::cout << "Parallel random search is correct!" << std::endl;
+        } else {
+            std::cout << "ERROR: Parallel random search gives a different result!" << std::endl;
+        }
+        
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;